@@ -0,0 +1,798 @@
+/* adaptive_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that implement std::map on sorted std::vector storage
+*  that adapts its layout to the observed workload.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the adaptive_sorted_map.hpp
+*  to your C++ project and include it.
+*
+*    #include "adaptive_sorted_map.hpp"
+*
+*  USAGE
+*
+*  This map support the same functionalty as sel.sorted_map. While lookups dominate the elements are kept in one
+*  flat sorted vector, when the share of inserts and erases in the last window of operations crosses
+*  segment_above the vector is split into sorted segments of about segment_size elements so that a write only
+*  shifts one segment. The segments are joined back into one vector when the write share drops below
+*  flatten_below, the gap between the two thresholds keeps the map from switching back and forth. A switch
+*  invalidates all iterators, just like an insert into sel.sorted_map does.
+*
+*  Only lookups through a non-const map are counted as reads and only non-const members switch the layout, so
+*  the const members never write and may be called from several threads at once, as on sel.sorted_map.
+*
+*    auto mymap = sel::adaptive_sorted_map<int,int>();
+*    auto policy = mymap.policy();
+*    policy.segment_size = 512;
+*    mymap.policy(policy);
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace sel
+{
+    struct adaptive_policy
+    {
+        std::size_t segment_size = 1024;
+        std::size_t min_segmented_size = 8192;
+        std::size_t window = 4096;
+        float segment_above = 0.2f;
+        float flatten_below = 0.02f;
+    };
+
+    template <class Key, class T, class Allocator = std::allocator<std::pair<Key,T>>>
+    class adaptive_sorted_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+
+    private:
+        typedef std::vector<value_type, Allocator> segment_type;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<segment_type> segment_allocator;
+
+        template <class Owner, class Value>
+        class basic_iterator {
+            friend class adaptive_sorted_map;
+            Owner *m_owner;
+            size_type m_segment;
+            size_type m_offset;
+
+            basic_iterator(Owner *owner, size_type segment, size_type offset) : m_owner(owner), m_segment(segment), m_offset(offset) {}
+
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef Value value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Value *pointer;
+            typedef Value &reference;
+
+            basic_iterator() : m_owner(nullptr), m_segment(0), m_offset(0) {}
+
+            template <class O, class V>
+            basic_iterator(const basic_iterator<O,V> &other) : m_owner(other.m_owner), m_segment(other.m_segment), m_offset(other.m_offset) {}
+
+            reference operator*() const
+            {
+                return m_owner->m_segments[m_segment][m_offset];
+            }
+
+            pointer operator->() const
+            {
+                return &m_owner->m_segments[m_segment][m_offset];
+            }
+
+            basic_iterator &operator++()
+            {
+                if (++m_offset == m_owner->m_segments[m_segment].size())
+                {
+                    ++m_segment;
+                    m_offset = 0;
+                }
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                auto result = *this;
+                ++(*this);
+                return result;
+            }
+
+            basic_iterator &operator--()
+            {
+                if (m_offset == 0)
+                {
+                    m_offset = m_owner->m_segments[--m_segment].size();
+                }
+                --m_offset;
+                return *this;
+            }
+
+            basic_iterator operator--(int)
+            {
+                auto result = *this;
+                --(*this);
+                return result;
+            }
+
+            template <class O, class V>
+            bool operator==(const basic_iterator<O,V> &other) const
+            {
+                return m_segment == other.m_segment && m_offset == other.m_offset;
+            }
+
+            template <class O, class V>
+            bool operator!=(const basic_iterator<O,V> &other) const
+            {
+                return !(*this == other);
+            }
+
+            template <class O, class V>
+            friend class basic_iterator;
+        };
+
+    public:
+        typedef basic_iterator<adaptive_sorted_map, value_type> iterator;
+        typedef basic_iterator<const adaptive_sorted_map, const value_type> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        std::vector<segment_type, segment_allocator> m_segments;
+        size_type m_size = 0;
+        bool m_segmented = false;
+        adaptive_policy m_policy;
+        size_type m_reads = 0;
+        size_type m_writes = 0;
+        Allocator m_alloc;
+
+        static bool key_less(const value_type &vt, const Key &k)
+        {
+            return vt.first < k;
+        }
+
+        static bool less_key(const Key &k, const value_type &vt)
+        {
+            return k < vt.first;
+        }
+
+        // Index of the first segment whose last key is not less than key, m_segments.size() when there is none.
+        size_type locate(const Key &key) const
+        {
+            if (m_segments.size() <= 1)
+            {
+                return m_segments.empty() || !(m_segments.front().back().first < key) ? 0 : m_segments.size();
+            }
+            return std::lower_bound(m_segments.begin(), m_segments.end(), key, [](const segment_type &s, const Key &k) {
+                return s.back().first < k;
+            }) - m_segments.begin();
+        }
+
+        size_type locate_upper(const Key &key) const
+        {
+            return std::upper_bound(m_segments.begin(), m_segments.end(), key, [](const Key &k, const segment_type &s) {
+                return k < s.back().first;
+            }) - m_segments.begin();
+        }
+
+        void record_write()
+        {
+            ++m_writes;
+            adapt();
+        }
+
+        void adapt()
+        {
+            auto total = m_reads + m_writes;
+            if (total < m_policy.window)
+            {
+                return;
+            }
+            float write_share = static_cast<float>(m_writes) / total;
+            m_reads = 0;
+            m_writes = 0;
+            if (!m_segmented && write_share > m_policy.segment_above && m_size >= m_policy.min_segmented_size)
+            {
+                segment();
+            }
+            else if (m_segmented && (write_share < m_policy.flatten_below || m_size < m_policy.min_segmented_size / 2))
+            {
+                flatten();
+            }
+        }
+
+        void segment()
+        {
+            auto count = std::max<size_type>(1, m_policy.segment_size);
+            std::vector<segment_type, segment_allocator> segments;
+            for (auto &source : m_segments)
+            {
+                for (size_type first = 0; first < source.size(); first += count)
+                {
+                    auto last = std::min(first + count, source.size());
+                    segments.emplace_back(std::make_move_iterator(source.begin() + first),
+                                          std::make_move_iterator(source.begin() + last), m_alloc);
+                }
+            }
+            m_segments.swap(segments);
+            m_segmented = true;
+        }
+
+        void flatten()
+        {
+            if (m_segments.size() > 1)
+            {
+                auto &front = m_segments.front();
+                front.reserve(m_size);
+                for (auto itr = m_segments.begin() + 1; itr != m_segments.end(); ++itr)
+                {
+                    front.insert(front.end(), std::make_move_iterator(itr->begin()), std::make_move_iterator(itr->end()));
+                }
+                m_segments.erase(m_segments.begin() + 1, m_segments.end());
+            }
+            m_segmented = false;
+        }
+
+        template <class V>
+        std::pair<iterator, bool> insert_value(V &&value)
+        {
+            record_write();
+            if (m_segments.empty())
+            {
+                m_segments.emplace_back(m_alloc);
+                m_segments.front().push_back(std::forward<V>(value));
+                m_size = 1;
+                return std::make_pair(begin(), true);
+            }
+            auto seg = std::min(locate(value.first), m_segments.size() - 1);
+            auto &items = m_segments[seg];
+            auto pos = std::lower_bound(items.begin(), items.end(), value.first, key_less);
+            size_type offset = pos - items.begin();
+            if (pos != items.end() && !(value.first < pos->first))
+            {
+                return std::make_pair(iterator(this, seg, offset), false);
+            }
+            items.insert(pos, std::forward<V>(value));
+            ++m_size;
+            if (m_segmented && items.size() > 2 * m_policy.segment_size)
+            {
+                auto half = items.size() / 2;
+                segment_type upper(std::make_move_iterator(items.begin() + half), std::make_move_iterator(items.end()), m_alloc);
+                items.erase(items.begin() + half, items.end());
+                m_segments.insert(m_segments.begin() + seg + 1, std::move(upper));
+                if (offset >= half)
+                {
+                    ++seg;
+                    offset -= half;
+                }
+            }
+            return std::make_pair(iterator(this, seg, offset), true);
+        }
+
+        // Removes [first, last) from one segment and returns the position that follows the removed elements.
+        iterator erase_in_segment(size_type seg, size_type first, size_type last)
+        {
+            auto &items = m_segments[seg];
+            items.erase(items.begin() + first, items.begin() + last);
+            m_size -= last - first;
+            if (items.empty())
+            {
+                m_segments.erase(m_segments.begin() + seg);
+                return iterator(this, seg, 0);
+            }
+            if (seg + 1 < m_segments.size() && items.size() < m_policy.segment_size / 4 &&
+                items.size() + m_segments[seg + 1].size() <= m_policy.segment_size)
+            {
+                auto &next = m_segments[seg + 1];
+                items.insert(items.end(), std::make_move_iterator(next.begin()), std::make_move_iterator(next.end()));
+                m_segments.erase(m_segments.begin() + seg + 1);
+            }
+            if (first == items.size())
+            {
+                return iterator(this, seg + 1, 0);
+            }
+            return iterator(this, seg, first);
+        }
+
+        template <class Owner, class Value>
+        static basic_iterator<Owner,Value> lower_bound_in(Owner *owner, const Key &key)
+        {
+            auto seg = owner->locate(key);
+            if (seg == owner->m_segments.size())
+            {
+                return basic_iterator<Owner,Value>(owner, seg, 0);
+            }
+            auto &items = owner->m_segments[seg];
+            auto pos = std::lower_bound(items.begin(), items.end(), key, key_less);
+            return basic_iterator<Owner,Value>(owner, seg, pos - items.begin());
+        }
+
+        template <class Owner, class Value>
+        static basic_iterator<Owner,Value> upper_bound_in(Owner *owner, const Key &key)
+        {
+            auto seg = owner->locate_upper(key);
+            if (seg == owner->m_segments.size())
+            {
+                return basic_iterator<Owner,Value>(owner, seg, 0);
+            }
+            auto &items = owner->m_segments[seg];
+            auto pos = std::upper_bound(items.begin(), items.end(), key, less_key);
+            return basic_iterator<Owner,Value>(owner, seg, pos - items.begin());
+        }
+
+        template <class Owner, class Value>
+        static basic_iterator<Owner,Value> find_in(Owner *owner, const Key &key)
+        {
+            auto result = lower_bound_in<Owner,Value>(owner, key);
+            if (result.m_segment != owner->m_segments.size() && !(key < result->first))
+            {
+                return result;
+            }
+            return basic_iterator<Owner,Value>(owner, owner->m_segments.size(), 0);
+        }
+
+    public:
+
+        adaptive_sorted_map() : m_alloc() {}
+
+        explicit adaptive_sorted_map(const Allocator &alloc) : m_alloc(alloc) {}
+
+        template <class InputIt>
+        adaptive_sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_alloc(alloc)
+        {
+            insert(first, last);
+        }
+
+        adaptive_sorted_map(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : adaptive_sorted_map(init.begin(), init.end(), alloc)
+        {
+        }
+
+        adaptive_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_alloc;
+        }
+
+        const adaptive_policy &policy() const noexcept
+        {
+            return m_policy;
+        }
+
+        void policy(const adaptive_policy &policy)
+        {
+            m_policy = policy;
+            if (m_segmented)
+            {
+                flatten();
+                segment();
+            }
+        }
+
+        bool is_segmented() const noexcept
+        {
+            return m_segmented;
+        }
+
+        void segment_now()
+        {
+            segment();
+        }
+
+        void flatten_now()
+        {
+            flatten();
+        }
+
+        T& at(const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in adaptive_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in adaptive_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        T& operator[](const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                return insert(value_type(key, T())).first->second;
+            }
+            return find_result->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                return insert(value_type(std::move(key), T())).first->second;
+            }
+            return find_result->second;
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(this, 0, 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(this, 0, 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(this, m_segments.size(), 0);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(this, m_segments.size(), 0);
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return std::allocator_traits<Allocator>::max_size(m_alloc);
+        }
+
+        void reserve(size_type new_cap)
+        {
+            if (!m_segmented && !m_segments.empty())
+            {
+                m_segments.front().reserve(new_cap);
+            }
+        }
+
+        size_type capacity() const noexcept
+        {
+            size_type result = 0;
+            for (auto &items : m_segments)
+            {
+                result += items.capacity();
+            }
+            return result;
+        }
+
+        void shrink_to_fit()
+        {
+            for (auto &items : m_segments)
+            {
+                items.shrink_to_fit();
+            }
+            m_segments.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_segments.clear();
+            m_size = 0;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return insert_value(value);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return insert_value(std::move(value));
+        }
+
+        iterator insert(const_iterator, const value_type &value)
+        {
+            return insert_value(value).first;
+        }
+
+        iterator insert(const_iterator, value_type &&value)
+        {
+            return insert_value(std::move(value)).first;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert_value(value_type(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator, Args &&...args)
+        {
+            return insert_value(value_type(std::forward<Args>(args)...)).first;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            ++m_writes;
+            return erase_in_segment(pos.m_segment, pos.m_offset, pos.m_offset + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            ++m_writes;
+            auto remaining = static_cast<size_type>(std::distance(first, last));
+            auto result = iterator(this, first.m_segment, first.m_offset);
+            while (remaining > 0)
+            {
+                auto count = std::min(remaining, m_segments[result.m_segment].size() - result.m_offset);
+                result = erase_in_segment(result.m_segment, result.m_offset, result.m_offset + count);
+                remaining -= count;
+            }
+            return result;
+        }
+
+        size_type erase(const Key &key)
+        {
+            record_write();
+            auto find_result = lower_bound_in<adaptive_sorted_map, value_type>(this, key);
+            if (find_result == end() || key < find_result->first)
+                return 0;
+            erase_in_segment(find_result.m_segment, find_result.m_offset, find_result.m_offset + 1);
+            return 1;
+        }
+
+        template <class InputIt>
+        size_type erase_keys(InputIt first, InputIt last)
+        {
+            size_type erased = 0;
+            for (auto itr = first; itr != last; ++itr)
+            {
+                erased += erase(*itr);
+            }
+            return erased;
+        }
+
+        void swap(adaptive_sorted_map &other)
+        {
+            m_segments.swap(other.m_segments);
+            std::swap(m_size, other.m_size);
+            std::swap(m_segmented, other.m_segmented);
+            std::swap(m_policy, other.m_policy);
+            std::swap(m_reads, other.m_reads);
+            std::swap(m_writes, other.m_writes);
+            std::swap(m_alloc, other.m_alloc);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == cend() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            ++m_reads;
+            adapt();
+            return find_in<adaptive_sorted_map, value_type>(this, key);
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return find_in<const adaptive_sorted_map, const value_type>(this, key);
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            ++m_reads;
+            return lower_bound_in<adaptive_sorted_map, value_type>(this, key);
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return lower_bound_in<const adaptive_sorted_map, const value_type>(this, key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            ++m_reads;
+            return upper_bound_in<adaptive_sorted_map, value_type>(this, key);
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return upper_bound_in<const adaptive_sorted_map, const value_type>(this, key);
+        }
+    };
+
+    template <class K, class V, class A>
+    bool operator==(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+
+    template <class K, class V, class A>
+    bool operator!=(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class K, class V, class A>
+    bool operator<(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    }
+
+    template <class K, class V, class A>
+    bool operator<=(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class K, class V, class A>
+    bool operator>(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class K, class V, class A>
+    bool operator>=(const adaptive_sorted_map<K,V,A> &lhs, const adaptive_sorted_map<K,V,A> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class K, class V, class A>
+    void swap(adaptive_sorted_map<K,V,A> &lhs, adaptive_sorted_map<K,V,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class V, class A, class Pred>
+    typename adaptive_sorted_map<K,V,A>::size_type erase_if(adaptive_sorted_map<K,V,A> &c, Pred pred)
+    {
+        typename adaptive_sorted_map<K,V,A>::size_type erased = 0;
+        for (auto itr = c.begin(); itr != c.end();)
+        {
+            if (pred(*itr))
+            {
+                itr = c.erase(itr);
+                ++erased;
+            }
+            else
+            {
+                ++itr;
+            }
+        }
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
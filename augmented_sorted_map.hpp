@@ -0,0 +1,600 @@
+/* augmented_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::map
+*  with range aggregate queries over the mapped values.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the augmented_sorted_map.hpp
+*  to your C++ project and include it.
+*
+*    #include "augmented_sorted_map.hpp"
+*
+*  USAGE
+*
+*  This map support the same functionalty as sel.sorted_map except that the mapped values are read only through
+*  the iterators, they are changed with update() or insert_or_assign() so the summary stays correct. The summary
+*  is a segment tree over the values for the operation given as the Op template argument, sel.sum_op,
+*  sel.min_op, sel.max_op or any type with an identity() and an associative call operator. Inserts and erases
+*  only mark the tree dirty from the first moved element, it is rebuilt from there by the next query.
+*
+*  Because of that aggregate() and select() write the tree although they are const. On a map shared between
+*  threads they must be synchronized like a write until one query after the last write has left the tree clean,
+*  from then on they only read, like the other const members.
+*
+*    auto mymap = sel::augmented_sorted_map<int, double>({{1, 0.5}, {2, 1.5}, {3, 2.0}});
+*    mymap.aggregate(1, 2);  // 2.0, the values with the keys 1 to 2
+*    mymap.select(1.0);      // iterator to {2, 1.5}, the first element where the running sum passes 1.0
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace sel
+{
+    template <class T>
+    struct sum_op
+    {
+        T identity() const
+        {
+            return T();
+        }
+
+        T operator()(const T &lhs, const T &rhs) const
+        {
+            return lhs + rhs;
+        }
+    };
+
+    template <class T>
+    struct min_op
+    {
+        T identity() const
+        {
+            return std::numeric_limits<T>::max();
+        }
+
+        T operator()(const T &lhs, const T &rhs) const
+        {
+            return std::min(lhs, rhs);
+        }
+    };
+
+    template <class T>
+    struct max_op
+    {
+        T identity() const
+        {
+            return std::numeric_limits<T>::lowest();
+        }
+
+        T operator()(const T &lhs, const T &rhs) const
+        {
+            return std::max(lhs, rhs);
+        }
+    };
+
+    template <class Key, class T, class Op = sum_op<T>, class Allocator = std::allocator<std::pair<Key,T>>>
+    class augmented_sorted_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef Op operation_type;
+        typedef const value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::const_pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::const_iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        template <class K, class V, class O, class A>
+        friend bool operator==(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend bool operator!=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend bool operator<(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend bool operator<=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend bool operator>(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend bool operator>=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs);
+        template <class K, class V, class O, class A>
+        friend void swap(augmented_sorted_map<K,V,O,A> &lhs, augmented_sorted_map<K,V,O,A> &rhs);
+        std::vector<value_type, Allocator> m_container;
+        Op m_op;
+        mutable std::vector<T> m_tree;
+        mutable size_type m_leaves = 0;
+        mutable size_type m_filled = 0;
+        mutable size_type m_dirty_from = 0;
+
+        static const size_type clean = static_cast<size_type>(-1);
+
+        static bool key_less(const value_type &vt, const Key &k)
+        {
+            return vt.first < k;
+        }
+
+        static bool less_key(const Key &k, const value_type &vt)
+        {
+            return k < vt.first;
+        }
+
+        void mark_dirty(size_type index)
+        {
+            m_dirty_from = std::min(m_dirty_from, index);
+        }
+
+        // Rebuilds the leaves from m_dirty_from and their ancestors, the whole tree when it has run out of leaves.
+        void refresh() const
+        {
+            auto size = m_container.size();
+            if (m_dirty_from == clean && size <= m_leaves)
+            {
+                return;
+            }
+            if (size > m_leaves)
+            {
+                m_leaves = 1;
+                while (m_leaves < size)
+                {
+                    m_leaves *= 2;
+                }
+                m_tree.assign(2 * m_leaves, m_op.identity());
+                m_filled = 0;
+                m_dirty_from = 0;
+            }
+            auto last = std::max(size, m_filled);
+            if (m_dirty_from >= last)
+            {
+                m_dirty_from = clean;
+                return;
+            }
+            for (auto index = m_dirty_from; index < last; ++index)
+            {
+                m_tree[m_leaves + index] = index < size ? m_container[index].second : m_op.identity();
+            }
+            for (auto lo = (m_leaves + m_dirty_from) / 2, hi = (m_leaves + last - 1) / 2; lo > 0; lo /= 2, hi /= 2)
+            {
+                for (auto node = lo; node <= hi; ++node)
+                {
+                    m_tree[node] = m_op(m_tree[2 * node], m_tree[2 * node + 1]);
+                }
+            }
+            m_filled = size;
+            m_dirty_from = clean;
+        }
+
+        template <class V>
+        const_iterator insert_at(const_iterator pos, V &&value)
+        {
+            auto index = static_cast<size_type>(pos - m_container.cbegin());
+            mark_dirty(index);
+            return m_container.insert(pos, std::forward<V>(value));
+        }
+
+    public:
+
+        augmented_sorted_map() : m_container() {}
+
+        explicit augmented_sorted_map(const Op &op, const Allocator &alloc = Allocator()) : m_container(alloc), m_op(op) {}
+
+        template <class InputIt>
+        augmented_sorted_map(InputIt first, InputIt last, const Op &op = Op(), const Allocator &alloc = Allocator())
+            : m_container(alloc), m_op(op)
+        {
+            insert(first, last);
+        }
+
+        augmented_sorted_map(std::initializer_list<value_type> init, const Op &op = Op(), const Allocator &alloc = Allocator())
+            : augmented_sorted_map(std::begin(init), std::end(init), op, alloc)
+        {
+        }
+
+        augmented_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        const Op &operation() const noexcept
+        {
+            return m_op;
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto find_result = find(key);
+            if(find_result == cend()) {
+                throw std::out_of_range("failed to find key in augmented_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+            mark_dirty(0);
+        }
+
+        std::pair<const_iterator, bool> insert(const value_type &value)
+        {
+            auto first = lower_bound(value.first);
+            if (!(first == m_container.cend()) && !(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            return std::make_pair(insert_at(first, value), true);
+        }
+
+        std::pair<const_iterator, bool> insert(value_type &&value)
+        {
+            auto first = lower_bound(value.first);
+            if (!(first == m_container.cend()) && !(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            return std::make_pair(insert_at(first, std::move(value)), true);
+        }
+
+        const_iterator insert(const_iterator pos, const value_type &value)
+        {
+            if ((pos == m_container.cbegin() || (pos - 1)->first < value.first) && (pos == m_container.cend() || value.first < pos->first))
+            {
+                return insert_at(pos, value);
+            }
+            return insert(value).first;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<const_iterator, bool> emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        std::pair<const_iterator, bool> insert_or_assign(const Key &key, const T &value)
+        {
+            auto first = lower_bound(key);
+            if (!(first == m_container.cend()) && !(key < first->first))
+            {
+                return std::make_pair(update(first, value), false);
+            }
+            return std::make_pair(insert_at(first, value_type(key, value)), true);
+        }
+
+        // Replaces the mapped value at pos, the path to the root is updated right away unless it is already dirty.
+        const_iterator update(const_iterator pos, const T &value)
+        {
+            auto index = static_cast<size_type>(pos - m_container.cbegin());
+            m_container[index].second = value;
+            if (m_dirty_from <= index || index >= m_filled)
+            {
+                mark_dirty(index);
+                return pos;
+            }
+            auto node = m_leaves + index;
+            m_tree[node] = value;
+            for (node /= 2; node > 0; node /= 2)
+            {
+                m_tree[node] = m_op(m_tree[2 * node], m_tree[2 * node + 1]);
+            }
+            return pos;
+        }
+
+        const_iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        const_iterator erase(const_iterator first, const_iterator last)
+        {
+            if (first != last)
+            {
+                mark_dirty(static_cast<size_type>(first - m_container.cbegin()));
+            }
+            return m_container.erase(first, last);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto find_result = find(key);
+            if (find_result == m_container.cend())
+                return 0;
+            erase(find_result);
+            return 1;
+        }
+
+        void swap(augmented_sorted_map &other)
+        {
+            m_container.swap(other.m_container);
+            std::swap(m_op, other.m_op);
+            m_tree.swap(other.m_tree);
+            std::swap(m_leaves, other.m_leaves);
+            std::swap(m_filled, other.m_filled);
+            std::swap(m_dirty_from, other.m_dirty_from);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == m_container.cend() ? 0 : 1;
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto first = lower_bound(key);
+            if (!(first == m_container.cend()) && !(key < first->first))
+            {
+                return first;
+            }
+            return m_container.cend();
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return std::lower_bound(m_container.cbegin(), m_container.cend(), key, key_less);
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return std::upper_bound(m_container.cbegin(), m_container.cend(), key, less_key);
+        }
+
+        T aggregate(const_iterator first, const_iterator last) const
+        {
+            refresh();
+            auto left = m_op.identity();
+            auto right = m_op.identity();
+            auto lo = m_leaves + static_cast<size_type>(first - m_container.cbegin());
+            auto hi = m_leaves + static_cast<size_type>(last - m_container.cbegin());
+            for (; lo < hi; lo /= 2, hi /= 2)
+            {
+                if (lo & 1)
+                {
+                    left = m_op(left, m_tree[lo++]);
+                }
+                if (hi & 1)
+                {
+                    right = m_op(m_tree[--hi], right);
+                }
+            }
+            return m_op(left, right);
+        }
+
+        // Aggregate of the values with keys in the closed range [lo, hi].
+        T aggregate(const Key &lo, const Key &hi) const
+        {
+            auto first = lower_bound(lo);
+            auto last = std::upper_bound(first, m_container.cend(), hi, less_key);
+            return aggregate(first, last);
+        }
+
+        T aggregate() const
+        {
+            return aggregate(m_container.cbegin(), m_container.cend());
+        }
+
+        // First element where the running aggregate from begin() exceeds weight, end() if there is none. The
+        // values must be non negative and Op a sum for the descent to be meaningful.
+        const_iterator select(T weight) const
+        {
+            refresh();
+            if (m_container.empty() || !(weight < m_tree[1]))
+            {
+                return m_container.cend();
+            }
+            size_type node = 1;
+            while (node < m_leaves)
+            {
+                if (weight < m_tree[2 * node])
+                {
+                    node = 2 * node;
+                }
+                else
+                {
+                    weight = weight - m_tree[2 * node];
+                    node = 2 * node + 1;
+                }
+            }
+            return m_container.cbegin() + (node - m_leaves);
+        }
+    };
+
+    template <class Key, class T, class Op, class Allocator>
+    const typename augmented_sorted_map<Key,T,Op,Allocator>::size_type augmented_sorted_map<Key,T,Op,Allocator>::clean;
+
+    template <class K, class V, class O, class A>
+    bool operator==(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container == rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    bool operator!=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container != rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    bool operator<(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container < rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    bool operator<=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container <= rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    bool operator>(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container > rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    bool operator>=(const augmented_sorted_map<K,V,O,A> &lhs, const augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        return lhs.m_container >= rhs.m_container;
+    }
+
+    template <class K, class V, class O, class A>
+    void swap(augmented_sorted_map<K,V,O,A> &lhs, augmented_sorted_map<K,V,O,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,454 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <set>
+#include <map>
+#include <unordered_set>
+#include <unordered_map>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#include "sorted_set.hpp"
+#include "sorted_map.hpp"
+
+// Benchmark harness for the sorted containers. Every measurement is printed as one CSV row (or one JSON object
+// with --format json) so the output can be stored and compared between releases.
+//
+//   sorted_container_bench [--min-size N] [--max-size N] [--min-ops N] [--max-quadratic N] [--format csv|json]
+
+struct options
+{
+    std::size_t min_size = 100;
+    std::size_t max_size = 1000000;
+    std::size_t min_ops = 1000000;
+    std::size_t max_quadratic = 100000;
+    bool json = false;
+};
+
+struct result
+{
+    std::string container;
+    std::string key_type;
+    std::string distribution;
+    std::string operation;
+    std::size_t size;
+    std::size_t ops;
+    double seconds;
+};
+
+static std::uint64_t g_sink = 0;
+static bool g_first_row = true;
+
+void print_header(const options &opts)
+{
+    if (opts.json)
+    {
+        std::cout << "[\n";
+    }
+    else
+    {
+        std::cout << "container,key_type,distribution,operation,size,ops,ns_per_op,ops_per_sec\n";
+    }
+}
+
+void print_footer(const options &opts)
+{
+    if (opts.json)
+    {
+        std::cout << "\n]\n";
+    }
+}
+
+void print_result(const options &opts, const result &r)
+{
+    double ns_per_op = r.seconds * 1e9 / r.ops;
+    double ops_per_sec = r.seconds > 0 ? r.ops / r.seconds : 0.0;
+    char numbers[128];
+    if (opts.json)
+    {
+        std::snprintf(numbers, sizeof(numbers), "\"size\": %zu, \"ops\": %zu, \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f",
+                      r.size, r.ops, ns_per_op, ops_per_sec);
+        std::cout << (g_first_row ? "" : ",\n")
+                  << "  {\"container\": \"" << r.container << "\", \"key_type\": \"" << r.key_type
+                  << "\", \"distribution\": \"" << r.distribution << "\", \"operation\": \"" << r.operation
+                  << "\", " << numbers << "}";
+    }
+    else
+    {
+        std::snprintf(numbers, sizeof(numbers), "%zu,%zu,%.3f,%.1f", r.size, r.ops, ns_per_op, ops_per_sec);
+        std::cout << r.container << ',' << r.key_type << ',' << r.distribution << ',' << r.operation << ',' << numbers << '\n';
+    }
+    g_first_row = false;
+    std::cout.flush();
+}
+
+// Bijective mix so that distinct indexes give distinct, uniformly spread keys.
+std::uint64_t permute(std::uint64_t x)
+{
+    x ^= x >> 31;
+    x *= 0x7fb5d329728ea185ULL;
+    x ^= x >> 27;
+    x *= 0x81dadef4bc2dd44dULL;
+    x ^= x >> 33;
+    return x;
+}
+
+template <class Key>
+struct key_traits;
+
+template <>
+struct key_traits<int>
+{
+    static const char *name() { return "int"; }
+    static int make(std::uint64_t v) { return static_cast<int>(static_cast<std::uint32_t>(v)); }
+    static std::uint64_t digest(int key) { return static_cast<std::uint64_t>(key); }
+};
+
+template <>
+struct key_traits<std::uint64_t>
+{
+    static const char *name() { return "uint64"; }
+    static std::uint64_t make(std::uint64_t v) { return v; }
+    static std::uint64_t digest(std::uint64_t key) { return key; }
+};
+
+template <>
+struct key_traits<std::string>
+{
+    static const char *name() { return "string"; }
+    static std::string make(std::uint64_t v)
+    {
+        char buffer[24];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(v));
+        return buffer;
+    }
+    static std::uint64_t digest(const std::string &key) { return key.size() + static_cast<unsigned char>(key[0]); }
+};
+
+// Hit keys are the even slots and miss keys the odd slots of the same sequence, so a miss is never present.
+// The uniform distribution spreads the slots with permute() and the sequential one keeps them in ascending order.
+template <class Key>
+void make_keys(std::size_t n, bool sequential, std::vector<Key> &hits, std::vector<Key> &misses)
+{
+    hits.clear();
+    misses.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::uint64_t hit = sequential ? 2 * i : permute(2 * i) & 0x7fffffff7ffffffeULL;
+        hits.push_back(key_traits<Key>::make(hit));
+        misses.push_back(key_traits<Key>::make(hit + 1));
+    }
+}
+
+template <class Container>
+struct container_traits;
+
+template <class Key>
+struct set_traits
+{
+    typedef Key value_type;
+    static const Key &make(const Key &key) { return key; }
+    static const Key &key(const Key &value) { return value; }
+};
+
+template <class Key>
+struct map_traits
+{
+    typedef std::pair<Key, std::uint64_t> value_type;
+    static value_type make(const Key &key) { return value_type(key, 1); }
+    template <class V>
+    static const Key &key(const V &value) { return value.first; }
+};
+
+template <class Key>
+struct container_traits<sel::sorted_set<Key>> : set_traits<Key>
+{
+    static const char *name() { return "sel::sorted_set"; }
+    static const bool ordered = true;
+    static const bool shifts = true;
+};
+
+template <class Key>
+struct container_traits<std::set<Key>> : set_traits<Key>
+{
+    static const char *name() { return "std::set"; }
+    static const bool ordered = true;
+    static const bool shifts = false;
+};
+
+template <class Key>
+struct container_traits<std::unordered_set<Key>> : set_traits<Key>
+{
+    static const char *name() { return "std::unordered_set"; }
+    static const bool ordered = false;
+    static const bool shifts = false;
+};
+
+template <class Key>
+struct container_traits<sel::sorted_map<Key, std::uint64_t>> : map_traits<Key>
+{
+    static const char *name() { return "sel::sorted_map"; }
+    static const bool ordered = true;
+    static const bool shifts = true;
+};
+
+template <class Key>
+struct container_traits<std::map<Key, std::uint64_t>> : map_traits<Key>
+{
+    static const char *name() { return "std::map"; }
+    static const bool ordered = true;
+    static const bool shifts = false;
+};
+
+template <class Key>
+struct container_traits<std::unordered_map<Key, std::uint64_t>> : map_traits<Key>
+{
+    static const char *name() { return "std::unordered_map"; }
+    static const bool ordered = false;
+    static const bool shifts = false;
+};
+
+template <class Container, class Fn>
+void measure(const options &opts, const char *distribution, const char *operation, std::size_t size, std::size_t ops, Fn fn)
+{
+    typedef container_traits<Container> traits;
+    typedef typename Container::key_type key_type;
+
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto stop = std::chrono::steady_clock::now();
+
+    result r;
+    r.container = traits::name();
+    r.key_type = key_traits<key_type>::name();
+    r.distribution = distribution;
+    r.operation = operation;
+    r.size = size;
+    r.ops = ops;
+    r.seconds = std::chrono::duration<double>(stop - start).count();
+    print_result(opts, r);
+}
+
+// The fixtures for the lookup benchmarks are built from sorted input so that they are cheap to set up for every
+// container, the construct benchmark uses the keys in distribution order.
+template <class Container>
+Container build(const std::vector<typename Container::key_type> &keys, bool sorted = true)
+{
+    typedef container_traits<Container> traits;
+    std::vector<typename traits::value_type> values;
+    values.reserve(keys.size());
+    for (const auto &key : keys)
+    {
+        values.push_back(traits::make(key));
+    }
+    if (sorted)
+    {
+        std::sort(values.begin(), values.end());
+    }
+    return Container(values.begin(), values.end());
+}
+
+template <class Container>
+void bench_ordered(const options &opts, const char *distribution, Container &container,
+                   const std::vector<typename Container::key_type> &misses, std::size_t rounds, std::true_type)
+{
+    typedef container_traits<Container> traits;
+    std::size_t n = misses.size();
+
+    measure<Container>(opts, distribution, "lower_bound", n, n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (const auto &key : misses)
+            {
+                auto itr = container.lower_bound(key);
+                g_sink += itr != container.end();
+            }
+        }
+    });
+
+    auto other = build<Container>(std::vector<typename Container::key_type>(misses.begin(), misses.end()));
+    measure<Container>(opts, distribution, "set_intersection", n, 2 * n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            auto first1 = container.begin(), last1 = container.end();
+            auto first2 = other.begin(), last2 = other.end();
+            while (first1 != last1 && first2 != last2)
+            {
+                if (traits::key(*first1) < traits::key(*first2))
+                {
+                    ++first1;
+                }
+                else
+                {
+                    g_sink += !(traits::key(*first2) < traits::key(*first1));
+                    ++first2;
+                }
+            }
+        }
+    });
+}
+
+template <class Container>
+void bench_ordered(const options &, const char *, Container &, const std::vector<typename Container::key_type> &,
+                   std::size_t, std::false_type)
+{
+}
+
+template <class Container>
+void bench_container(const options &opts, const char *distribution, std::size_t n,
+                     const std::vector<typename Container::key_type> &hits,
+                     const std::vector<typename Container::key_type> &misses,
+                     const std::vector<typename Container::key_type> &lookups)
+{
+    typedef container_traits<Container> traits;
+    bool sequential = std::strcmp(distribution, "sequential") == 0;
+    std::size_t rounds = std::max<std::size_t>(1, opts.min_ops / n);
+
+    bool quadratic = traits::shifts && !sequential && n > opts.max_quadratic;
+
+    if (!quadratic)
+    {
+        measure<Container>(opts, distribution, "construct", n, n, [&]() {
+            auto container = build<Container>(hits, false);
+            g_sink += container.size();
+        });
+
+        measure<Container>(opts, distribution, "insert", n, n, [&]() {
+            Container container;
+            for (const auto &key : hits)
+            {
+                container.insert(traits::make(key));
+            }
+            g_sink += container.size();
+        });
+    }
+
+    auto container = build<Container>(hits);
+
+    measure<Container>(opts, distribution, "find_hit", n, n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (const auto &key : lookups)
+            {
+                g_sink += container.find(key) != container.end();
+            }
+        }
+    });
+
+    measure<Container>(opts, distribution, "find_miss", n, n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (const auto &key : misses)
+            {
+                g_sink += container.find(key) != container.end();
+            }
+        }
+    });
+
+    measure<Container>(opts, distribution, "iterate", n, n * rounds, [&]() {
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            for (const auto &value : container)
+            {
+                g_sink += key_traits<typename Container::key_type>::digest(traits::key(value));
+            }
+        }
+    });
+
+    bench_ordered(opts, distribution, container, misses, rounds, std::integral_constant<bool, traits::ordered>());
+
+    std::size_t erases = std::min<std::size_t>(n, 1000);
+    measure<Container>(opts, distribution, "erase", n, erases, [&]() {
+        for (std::size_t i = 0; i < erases; ++i)
+        {
+            g_sink += container.erase(lookups[i]);
+        }
+    });
+}
+
+template <class Key>
+void bench_key(const options &opts)
+{
+    std::vector<Key> hits, misses;
+    std::mt19937_64 rng(42);
+
+    for (std::size_t n = opts.min_size; n <= opts.max_size; n *= 10)
+    {
+        for (int sequential = 1; sequential >= 0; --sequential)
+        {
+            const char *distribution = sequential ? "sequential" : "uniform";
+            make_keys(n, sequential != 0, hits, misses);
+            auto lookups = hits;
+            std::shuffle(lookups.begin(), lookups.end(), rng);
+
+            bench_container<sel::sorted_set<Key>>(opts, distribution, n, hits, misses, lookups);
+            bench_container<std::set<Key>>(opts, distribution, n, hits, misses, lookups);
+            bench_container<std::unordered_set<Key>>(opts, distribution, n, hits, misses, lookups);
+            bench_container<sel::sorted_map<Key, std::uint64_t>>(opts, distribution, n, hits, misses, lookups);
+            bench_container<std::map<Key, std::uint64_t>>(opts, distribution, n, hits, misses, lookups);
+            bench_container<std::unordered_map<Key, std::uint64_t>>(opts, distribution, n, hits, misses, lookups);
+        }
+    }
+}
+
+bool parse_options(int argc, char **argv, options &opts)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--min-size")
+        {
+            opts.min_size = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--max-size")
+        {
+            opts.max_size = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--min-ops")
+        {
+            opts.min_ops = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--max-quadratic")
+        {
+            opts.max_quadratic = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--format" && (value == "csv" || value == "json"))
+        {
+            opts.json = value == "json";
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return opts.min_size > 0 && opts.min_size <= opts.max_size;
+}
+
+int main(int argc, char **argv)
+{
+    options opts;
+    if (!parse_options(argc, argv, opts))
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " [--min-size N] [--max-size N] [--min-ops N] [--max-quadratic N] [--format csv|json]\n";
+        return 1;
+    }
+
+    print_header(opts);
+    bench_key<int>(opts);
+    bench_key<std::uint64_t>(opts);
+    bench_key<std::string>(opts);
+    print_footer(opts);
+
+    return g_sink == 0 ? 1 : 0;
+}
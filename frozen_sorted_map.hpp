@@ -0,0 +1,455 @@
+/* frozen_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that implement a read only std::map on sorted
+*  std::vector storage with a minimal perfect hash index for the point lookups.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the frozen_sorted_map.hpp
+*  and sorted_map.hpp to your C++ project and include it.
+*
+*    #include "frozen_sorted_map.hpp"
+*
+*  USAGE
+*
+*  The map is built once, usually by moving a finished sel.sorted_map into it, and the keys can not change after
+*  that. The constructor builds a hash and displace minimal perfect hash that sends every key straight to its
+*  position in the sorted vector, find, count and at hash the key, read one displacement and one slot and
+*  compare the key once. lower_bound, upper_bound, equal_range and iteration use the sorted vector as usual.
+*  If the Hash gives two keys the same hash value no perfect hash exists and the lookups fall back to binary
+*  search, hashed() tells which one is in use.
+*
+*    auto mymap = sel::sorted_map<int,int>({{1, 101}, {2, 202}});
+*    auto frozen = sel::frozen_sorted_map<int,int>(std::move(mymap));
+*    frozen.at(2);  // 202
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <stdexcept>
+
+#include "sorted_map.hpp"
+
+namespace sel
+{
+    template <class Key, class T, class Hash = std::hash<Key>, class Allocator = std::allocator<std::pair<Key,T>>>
+    class frozen_sorted_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Hash hasher;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static const unsigned max_seeds = 4;
+
+    private:
+        template <class K, class V, class H, class A>
+        friend bool operator==(const frozen_sorted_map<K,V,H,A> &lhs, const frozen_sorted_map<K,V,H,A> &rhs);
+        template <class K, class V, class H, class A>
+        friend bool operator!=(const frozen_sorted_map<K,V,H,A> &lhs, const frozen_sorted_map<K,V,H,A> &rhs);
+        std::vector<value_type, Allocator> m_container;
+        std::vector<std::uint32_t> m_displacements;
+        std::vector<std::uint32_t> m_slots;
+        std::uint64_t m_seed = 0;
+        Hash m_hash;
+
+        static std::uint64_t mix(std::uint64_t x)
+        {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            return x ^ (x >> 31);
+        }
+
+        // Maps x evenly onto [0, n) with a multiply and a shift instead of a division.
+        static std::size_t reduce(std::uint64_t x, std::size_t n)
+        {
+            return static_cast<std::size_t>(((x >> 32) * static_cast<std::uint64_t>(n)) >> 32);
+        }
+
+        std::uint64_t hash_of(const Key &key) const
+        {
+            return mix(static_cast<std::uint64_t>(m_hash(key)) ^ m_seed);
+        }
+
+        std::size_t slot_of(std::uint64_t h, std::uint32_t displacement) const
+        {
+            return reduce(mix(h + displacement * 0x9e3779b97f4a7c15ull), m_slots.size());
+        }
+
+        const_iterator search_lower(const Key &key) const
+        {
+            return std::lower_bound(m_container.cbegin(), m_container.cend(), key, [](const value_type &vt, const Key &k) {
+                return vt.first < k;
+            });
+        }
+
+        const_iterator search_upper(const Key &key) const
+        {
+            return std::upper_bound(m_container.cbegin(), m_container.cend(), key, [](const Key &k, const value_type &vt) {
+                return k < vt.first;
+            });
+        }
+
+        size_type index_of(const Key &key) const
+        {
+            if (m_slots.empty())
+            {
+                auto first = search_lower(key);
+                return first == m_container.cend() || key < first->first ? m_container.size() : first - m_container.cbegin();
+            }
+            auto h = hash_of(key);
+            auto index = m_slots[slot_of(h, m_displacements[reduce(h, m_displacements.size())])];
+            auto &value = m_container[index];
+            return value.first < key || key < value.first ? m_container.size() : index;
+        }
+
+        bool try_build()
+        {
+            auto n = m_container.size();
+            auto bucket_count = n / 2 + 1;
+            auto hashes = std::vector<std::uint64_t>(n);
+            auto order = std::vector<std::pair<std::uint32_t, std::uint32_t>>(n);
+            for (size_type i = 0; i < n; ++i)
+            {
+                hashes[i] = hash_of(m_container[i].first);
+                order[i] = std::make_pair(static_cast<std::uint32_t>(reduce(hashes[i], bucket_count)), static_cast<std::uint32_t>(i));
+            }
+            std::sort(order.begin(), order.end());
+
+            auto sorted_hashes = hashes;
+            std::sort(sorted_hashes.begin(), sorted_hashes.end());
+            if (std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) != sorted_hashes.end())
+            {
+                return false;
+            }
+
+            auto buckets = std::vector<std::pair<size_type, size_type>>();
+            for (size_type first = 0; first < n;)
+            {
+                auto last = first;
+                while (last < n && order[last].first == order[first].first)
+                {
+                    ++last;
+                }
+                buckets.push_back(std::make_pair(first, last));
+                first = last;
+            }
+            std::stable_sort(buckets.begin(), buckets.end(), [](const std::pair<size_type, size_type> &lhs, const std::pair<size_type, size_type> &rhs) {
+                return lhs.second - lhs.first > rhs.second - rhs.first;
+            });
+
+            m_displacements.assign(bucket_count, 0);
+            m_slots.assign(n, 0);
+            auto taken = std::vector<bool>(n, false);
+            auto slots = std::vector<size_type>();
+            // The last single key buckets search for one of the few free slots left, about n tries each.
+            auto max_displacement = static_cast<std::uint32_t>(std::min<std::uint64_t>(UINT32_MAX, std::max<std::uint64_t>(1u << 16, 32ull * n)));
+            for (auto &bucket : buckets)
+            {
+                bool placed = false;
+                for (std::uint32_t displacement = 0; displacement < max_displacement && !placed; ++displacement)
+                {
+                    slots.clear();
+                    placed = true;
+                    for (auto i = bucket.first; i < bucket.second && placed; ++i)
+                    {
+                        auto slot = slot_of(hashes[order[i].second], displacement);
+                        placed = !taken[slot] && std::find(slots.begin(), slots.end(), slot) == slots.end();
+                        slots.push_back(slot);
+                    }
+                    if (placed)
+                    {
+                        m_displacements[order[bucket.first].first] = displacement;
+                        for (auto i = bucket.first; i < bucket.second; ++i)
+                        {
+                            taken[slots[i - bucket.first]] = true;
+                            m_slots[slots[i - bucket.first]] = order[i].second;
+                        }
+                    }
+                }
+                if (!placed)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void build()
+        {
+            if (m_container.empty() || m_container.size() > UINT32_MAX)
+            {
+                return;
+            }
+            for (unsigned seed = 0; seed < max_seeds; ++seed)
+            {
+                m_seed = mix(seed + 1);
+                if (try_build())
+                {
+                    return;
+                }
+            }
+            m_displacements.clear();
+            m_slots.clear();
+        }
+
+    public:
+
+        frozen_sorted_map() : m_container() {}
+
+        template <class A, class S>
+        explicit frozen_sorted_map(const sorted_map<Key, T, A, S> &source, const Hash &hash = Hash(), const Allocator &alloc = Allocator())
+            : m_container(source.cbegin(), source.cend(), alloc), m_hash(hash)
+        {
+            build();
+        }
+
+        template <class S>
+        explicit frozen_sorted_map(sorted_map<Key, T, Allocator, S> &&source, const Hash &hash = Hash())
+            : m_container(source.get_allocator()), m_hash(hash)
+        {
+            m_container.assign(std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+            source.clear();
+            build();
+        }
+
+        template <class InputIt>
+        frozen_sorted_map(InputIt first, InputIt last, const Hash &hash = Hash(), const Allocator &alloc = Allocator())
+            : frozen_sorted_map(sorted_map<Key, T, Allocator>(first, last, alloc), hash)
+        {
+        }
+
+        frozen_sorted_map(std::initializer_list<value_type> init, const Hash &hash = Hash(), const Allocator &alloc = Allocator())
+            : frozen_sorted_map(init.begin(), init.end(), hash, alloc)
+        {
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        hasher hash_function() const
+        {
+            return m_hash;
+        }
+
+        bool hashed() const noexcept
+        {
+            return !m_slots.empty();
+        }
+
+        T& at(const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in frozen_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto find_result = find(key);
+            if(find_result == cend()) {
+                throw std::out_of_range("failed to find key in frozen_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        iterator begin() noexcept
+        {
+            return m_container.begin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return m_container.rbegin();
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return m_container.rend();
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void swap(frozen_sorted_map &other)
+        {
+            m_container.swap(other.m_container);
+            m_displacements.swap(other.m_displacements);
+            m_slots.swap(other.m_slots);
+            std::swap(m_seed, other.m_seed);
+            std::swap(m_hash, other.m_hash);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return index_of(key) == m_container.size() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            return m_container.begin() + index_of(key);
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return m_container.cbegin() + index_of(key);
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return m_container.begin() + (search_lower(key) - m_container.cbegin());
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return search_lower(key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return m_container.begin() + (search_upper(key) - m_container.cbegin());
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return search_upper(key);
+        }
+    };
+
+    template <class Key, class T, class Hash, class Allocator>
+    const unsigned frozen_sorted_map<Key, T, Hash, Allocator>::max_seeds;
+
+    template <class K, class V, class H, class A>
+    bool operator==(const frozen_sorted_map<K,V,H,A> &lhs, const frozen_sorted_map<K,V,H,A> &rhs)
+    {
+        return lhs.m_container == rhs.m_container;
+    }
+
+    template <class K, class V, class H, class A>
+    bool operator!=(const frozen_sorted_map<K,V,H,A> &lhs, const frozen_sorted_map<K,V,H,A> &rhs)
+    {
+        return lhs.m_container != rhs.m_container;
+    }
+
+    template <class K, class V, class H, class A>
+    void swap(frozen_sorted_map<K,V,H,A> &lhs, frozen_sorted_map<K,V,H,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
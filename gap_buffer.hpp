@@ -0,0 +1,672 @@
+/* gap_buffer.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with a std::vector like container that keeps its free
+*  capacity as a gap at the position of the last insert or erase. It is the storage used by sel.gap_sorted_set
+*  and sel.gap_sorted_map.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the gap_buffer.hpp
+*  to your C++ project and include it.
+*
+*    #include "gap_buffer.hpp"
+*
+*  USAGE
+*
+*  The buffer support the subset of [std::vector](https://en.cppreference.com/w/cpp/container/vector) that the
+*  sorted containers need. An insert or erase first moves the gap to its position, so edits close to each other
+*  only move the elements between them instead of the whole tail. The iterators are random access and step over
+*  the gap, they are invalidated by every insert and erase.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <iterator>
+
+namespace sel
+{
+    template <class T, class Allocator = std::allocator<T>>
+    class gap_buffer {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef value_type *pointer;
+        typedef const value_type *const_pointer;
+
+    private:
+        template <class Value>
+        class basic_iterator {
+            friend class gap_buffer;
+            Value *m_data;
+            size_type m_gap_begin;
+            size_type m_gap_size;
+            std::ptrdiff_t m_index;
+
+            basic_iterator(Value *data, size_type gap_begin, size_type gap_size, std::ptrdiff_t index)
+                : m_data(data), m_gap_begin(gap_begin), m_gap_size(gap_size), m_index(index) {}
+
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef Value value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Value *pointer;
+            typedef Value &reference;
+
+            basic_iterator() : m_data(nullptr), m_gap_begin(0), m_gap_size(0), m_index(0) {}
+
+            template <class V>
+            basic_iterator(const basic_iterator<V> &other)
+                : m_data(other.m_data), m_gap_begin(other.m_gap_begin), m_gap_size(other.m_gap_size), m_index(other.m_index) {}
+
+            reference operator*() const
+            {
+                return m_data[static_cast<size_type>(m_index) < m_gap_begin ? m_index : m_index + m_gap_size];
+            }
+
+            pointer operator->() const
+            {
+                return &**this;
+            }
+
+            reference operator[](difference_type n) const
+            {
+                return *(*this + n);
+            }
+
+            basic_iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                auto result = *this;
+                ++m_index;
+                return result;
+            }
+
+            basic_iterator &operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            basic_iterator operator--(int)
+            {
+                auto result = *this;
+                --m_index;
+                return result;
+            }
+
+            basic_iterator &operator+=(difference_type n)
+            {
+                m_index += n;
+                return *this;
+            }
+
+            basic_iterator &operator-=(difference_type n)
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            basic_iterator operator+(difference_type n) const
+            {
+                auto result = *this;
+                return result += n;
+            }
+
+            friend basic_iterator operator+(difference_type n, const basic_iterator &itr)
+            {
+                return itr + n;
+            }
+
+            basic_iterator operator-(difference_type n) const
+            {
+                auto result = *this;
+                return result -= n;
+            }
+
+            template <class V>
+            difference_type operator-(const basic_iterator<V> &other) const
+            {
+                return m_index - other.m_index;
+            }
+
+            template <class V>
+            bool operator==(const basic_iterator<V> &other) const
+            {
+                return m_index == other.m_index;
+            }
+
+            template <class V>
+            bool operator!=(const basic_iterator<V> &other) const
+            {
+                return m_index != other.m_index;
+            }
+
+            template <class V>
+            bool operator<(const basic_iterator<V> &other) const
+            {
+                return m_index < other.m_index;
+            }
+
+            template <class V>
+            bool operator<=(const basic_iterator<V> &other) const
+            {
+                return m_index <= other.m_index;
+            }
+
+            template <class V>
+            bool operator>(const basic_iterator<V> &other) const
+            {
+                return m_index > other.m_index;
+            }
+
+            template <class V>
+            bool operator>=(const basic_iterator<V> &other) const
+            {
+                return m_index >= other.m_index;
+            }
+
+            template <class V>
+            friend class basic_iterator;
+        };
+
+    public:
+        typedef basic_iterator<value_type> iterator;
+        typedef basic_iterator<const value_type> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        typedef std::allocator_traits<Allocator> traits;
+
+        T *m_data;
+        size_type m_capacity;
+        size_type m_gap_begin;
+        size_type m_gap_end;
+        Allocator m_alloc;
+
+        size_type gap_size() const noexcept
+        {
+            return m_gap_end - m_gap_begin;
+        }
+
+        size_type physical(size_type index) const noexcept
+        {
+            return index < m_gap_begin ? index : index + gap_size();
+        }
+
+        void destroy_all() noexcept
+        {
+            for (size_type i = 0; i < m_gap_begin; ++i)
+            {
+                traits::destroy(m_alloc, m_data + i);
+            }
+            for (size_type i = m_gap_end; i < m_capacity; ++i)
+            {
+                traits::destroy(m_alloc, m_data + i);
+            }
+            m_gap_begin = 0;
+            m_gap_end = m_capacity;
+        }
+
+        void release() noexcept
+        {
+            if (m_data != nullptr)
+            {
+                traits::deallocate(m_alloc, m_data, m_capacity);
+                m_data = nullptr;
+                m_capacity = 0;
+                m_gap_begin = 0;
+                m_gap_end = 0;
+            }
+        }
+
+        // Moves the gap so that it starts at the logical index, only the elements between the old and the new
+        // position are moved.
+        void move_gap(size_type index)
+        {
+            while (index < m_gap_begin)
+            {
+                --m_gap_begin;
+                --m_gap_end;
+                traits::construct(m_alloc, m_data + m_gap_end, std::move(m_data[m_gap_begin]));
+                traits::destroy(m_alloc, m_data + m_gap_begin);
+            }
+            while (index > m_gap_begin)
+            {
+                traits::construct(m_alloc, m_data + m_gap_begin, std::move(m_data[m_gap_end]));
+                traits::destroy(m_alloc, m_data + m_gap_end);
+                ++m_gap_begin;
+                ++m_gap_end;
+            }
+        }
+
+        // Moves the elements to a new allocation with new_cap slots and the gap at the logical index.
+        void relocate(size_type new_cap, size_type index)
+        {
+            auto count = size();
+            T *new_data = new_cap == 0 ? nullptr : traits::allocate(m_alloc, new_cap);
+            auto new_gap_end = new_cap - (count - index);
+            for (size_type i = 0; i < count; ++i)
+            {
+                auto from = physical(i);
+                traits::construct(m_alloc, new_data + (i < index ? i : i - index + new_gap_end), std::move_if_noexcept(m_data[from]));
+                traits::destroy(m_alloc, m_data + from);
+            }
+            if (m_data != nullptr)
+            {
+                traits::deallocate(m_alloc, m_data, m_capacity);
+            }
+            m_data = new_data;
+            m_capacity = new_cap;
+            m_gap_begin = index;
+            m_gap_end = new_gap_end;
+        }
+
+        void steal(gap_buffer &other)
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            m_gap_begin = other.m_gap_begin;
+            m_gap_end = other.m_gap_end;
+            other.m_data = nullptr;
+            other.m_capacity = 0;
+            other.m_gap_begin = 0;
+            other.m_gap_end = 0;
+        }
+
+    public:
+
+        gap_buffer() : m_data(nullptr), m_capacity(0), m_gap_begin(0), m_gap_end(0), m_alloc() {}
+
+        explicit gap_buffer(const Allocator &alloc) : m_data(nullptr), m_capacity(0), m_gap_begin(0), m_gap_end(0), m_alloc(alloc) {}
+
+        gap_buffer(const gap_buffer &other)
+            : gap_buffer(traits::select_on_container_copy_construction(other.m_alloc))
+        {
+            assign(other.begin(), other.end());
+        }
+
+        gap_buffer(const gap_buffer &other, const Allocator &alloc) : gap_buffer(alloc)
+        {
+            assign(other.begin(), other.end());
+        }
+
+        gap_buffer(gap_buffer &&other) : gap_buffer(other.m_alloc)
+        {
+            steal(other);
+        }
+
+        gap_buffer(gap_buffer &&other, const Allocator &alloc) : gap_buffer(alloc)
+        {
+            if (m_alloc == other.m_alloc)
+            {
+                steal(other);
+            }
+            else
+            {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
+        }
+
+        ~gap_buffer()
+        {
+            destroy_all();
+            release();
+        }
+
+        gap_buffer &operator=(const gap_buffer &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        gap_buffer &operator=(gap_buffer &&other)
+        {
+            if (this != &other)
+            {
+                destroy_all();
+                if (m_alloc == other.m_alloc)
+                {
+                    release();
+                    steal(other);
+                }
+                else
+                {
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                }
+            }
+            return *this;
+        }
+
+        template <class InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            for (auto itr = first; itr != last; ++itr)
+            {
+                emplace_back(*itr);
+            }
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_alloc;
+        }
+
+        reference operator[](size_type pos)
+        {
+            return m_data[physical(pos)];
+        }
+
+        const_reference operator[](size_type pos) const
+        {
+            return m_data[physical(pos)];
+        }
+
+        reference front()
+        {
+            return (*this)[0];
+        }
+
+        const_reference front() const
+        {
+            return (*this)[0];
+        }
+
+        reference back()
+        {
+            return (*this)[size() - 1];
+        }
+
+        const_reference back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(m_data, m_gap_begin, gap_size(), 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(m_data, m_gap_begin, gap_size(), 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(m_data, m_gap_begin, gap_size(), size());
+        }
+
+        const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(m_data, m_gap_begin, gap_size(), size());
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_capacity - gap_size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return traits::max_size(m_alloc);
+        }
+
+        void reserve(size_type new_cap)
+        {
+            if (new_cap > m_capacity)
+            {
+                relocate(new_cap, m_gap_begin);
+            }
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        void shrink_to_fit()
+        {
+            if (size() < m_capacity)
+            {
+                relocate(size(), m_gap_begin);
+            }
+        }
+
+        size_type gap_position() const noexcept
+        {
+            return m_gap_begin;
+        }
+
+        void clear() noexcept
+        {
+            destroy_all();
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            auto index = static_cast<size_type>(pos.m_index);
+            T value(std::forward<Args>(args)...);
+            if (m_gap_begin == m_gap_end)
+            {
+                relocate(std::max<size_type>(16, m_capacity * 2), index);
+            }
+            else
+            {
+                move_gap(index);
+            }
+            traits::construct(m_alloc, m_data + m_gap_begin, std::move(value));
+            ++m_gap_begin;
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, const T &value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class... Args>
+        reference emplace_back(Args &&...args)
+        {
+            return *emplace(cend(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            erase(cend() - 1);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto index = static_cast<size_type>(first.m_index);
+            auto count = static_cast<size_type>(last - first);
+            if (count > 0)
+            {
+                if (m_gap_begin <= index)
+                {
+                    move_gap(index);
+                    for (size_type i = 0; i < count; ++i)
+                    {
+                        traits::destroy(m_alloc, m_data + m_gap_end++);
+                    }
+                }
+                else
+                {
+                    move_gap(index + count);
+                    for (size_type i = 0; i < count; ++i)
+                    {
+                        traits::destroy(m_alloc, m_data + --m_gap_begin);
+                    }
+                }
+            }
+            return begin() + index;
+        }
+
+        void swap(gap_buffer &other)
+        {
+            auto tmp = std::move(other);
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    };
+
+    template <class T, class A>
+    bool operator==(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class A>
+    bool operator!=(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, class A>
+    bool operator<(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, class A>
+    bool operator<=(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class T, class A>
+    bool operator>(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, class A>
+    bool operator>=(const gap_buffer<T,A> &lhs, const gap_buffer<T,A> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class T, class A>
+    void swap(gap_buffer<T,A> &lhs, gap_buffer<T,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,607 @@
+/* lazy_sorted_set.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::set
+*  where erase only marks the slot as dead (a tombstone) instead of shifting the tail of the vector.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the lazy_sorted_set.hpp
+*  to your C++ project and include it.
+*
+*    #include "lazy_sorted_set.hpp"
+*
+*  USAGE
+*
+*  This set support the same functionalty as sel.sorted_set. Searches and iterators skip the dead slots,
+*  inserting a key that has a tombstone revives the slot in place and the dead slots are removed in one pass
+*  when the dead fraction crosses max_dead_ratio() or when compact() is called. Erase does not invalidate
+*  iterators unless it triggers a compaction.
+*
+*    auto myset = sel::lazy_sorted_set<int>({1, 2, 3});
+*    myset.max_dead_ratio(0.5);
+*    myset.erase(1);
+*    myset.compact();
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace sel
+{
+    template <class Key, class Allocator = std::allocator<Key>>
+    class lazy_sorted_set {
+        template <class Container, class Value>
+        class basic_iterator {
+            friend class lazy_sorted_set;
+            Container *m_owner;
+            std::size_t m_index;
+
+            basic_iterator(Container *owner, std::size_t index) : m_owner(owner), m_index(index) {}
+
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef Value value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef Value *pointer;
+            typedef Value &reference;
+
+            basic_iterator() : m_owner(nullptr), m_index(0) {}
+
+            template <class C, class V>
+            basic_iterator(const basic_iterator<C,V> &other) : m_owner(other.m_owner), m_index(other.m_index) {}
+
+            reference operator*() const
+            {
+                return m_owner->m_container[m_index];
+            }
+
+            pointer operator->() const
+            {
+                return &m_owner->m_container[m_index];
+            }
+
+            basic_iterator &operator++()
+            {
+                m_index = m_owner->next_live(m_index + 1);
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                auto result = *this;
+                ++(*this);
+                return result;
+            }
+
+            basic_iterator &operator--()
+            {
+                m_index = m_owner->prev_live(m_index);
+                return *this;
+            }
+
+            basic_iterator operator--(int)
+            {
+                auto result = *this;
+                --(*this);
+                return result;
+            }
+
+            template <class C, class V>
+            bool operator==(const basic_iterator<C,V> &other) const
+            {
+                return m_index == other.m_index;
+            }
+
+            template <class C, class V>
+            bool operator!=(const basic_iterator<C,V> &other) const
+            {
+                return m_index != other.m_index;
+            }
+
+            template <class C, class V>
+            friend class basic_iterator;
+        };
+
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef basic_iterator<lazy_sorted_set, value_type> iterator;
+        typedef basic_iterator<const lazy_sorted_set, const value_type> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        std::vector<value_type, allocator_type> m_container;
+        std::vector<bool> m_dead;
+        size_type m_dead_count = 0;
+        float m_max_dead_ratio = 0.25f;
+
+        static bool key_less(const value_type &vt, const Key &k)
+        {
+            return vt < k;
+        }
+
+        size_type next_live(size_type index) const
+        {
+            while (index < m_dead.size() && m_dead[index])
+            {
+                ++index;
+            }
+            return index;
+        }
+
+        size_type prev_live(size_type index) const
+        {
+            do
+            {
+                --index;
+            } while (m_dead[index]);
+            return index;
+        }
+
+        size_type search(const Key &key) const
+        {
+            return std::lower_bound(m_container.begin(), m_container.end(), key, key_less) - m_container.begin();
+        }
+
+        size_type live_before(size_type index) const
+        {
+            return index - std::count(m_dead.begin(), m_dead.begin() + index, true);
+        }
+
+        size_type kill(size_type index)
+        {
+            m_dead[index] = true;
+            ++m_dead_count;
+            if (m_dead_count > m_max_dead_ratio * m_container.size())
+            {
+                auto live_index = live_before(index);
+                compact();
+                return live_index;
+            }
+            return next_live(index);
+        }
+
+        template <class V>
+        std::pair<iterator, bool> insert_at(size_type index, V &&value)
+        {
+            if (index < m_container.size() && !(value < m_container[index]))
+            {
+                if (!m_dead[index])
+                {
+                    return std::make_pair(iterator(this, index), false);
+                }
+                m_container[index] = std::forward<V>(value);
+            }
+            else if (index < m_container.size() && m_dead[index])
+            {
+                m_container[index] = std::forward<V>(value);
+            }
+            else if (index > 0 && m_dead[index - 1])
+            {
+                m_container[--index] = std::forward<V>(value);
+            }
+            else
+            {
+                m_container.insert(m_container.begin() + index, std::forward<V>(value));
+                m_dead.insert(m_dead.begin() + index, false);
+                return std::make_pair(iterator(this, index), true);
+            }
+            m_dead[index] = false;
+            --m_dead_count;
+            return std::make_pair(iterator(this, index), true);
+        }
+
+    public:
+
+        lazy_sorted_set() {}
+
+        explicit lazy_sorted_set(const Allocator &alloc) : m_container(alloc) {}
+
+        template <class InputIt>
+        lazy_sorted_set(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            insert(first, last);
+        }
+
+        lazy_sorted_set(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : lazy_sorted_set(init.begin(), init.end(), alloc)
+        {
+        }
+
+        lazy_sorted_set &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        float max_dead_ratio() const noexcept
+        {
+            return m_max_dead_ratio;
+        }
+
+        void max_dead_ratio(float ratio)
+        {
+            m_max_dead_ratio = ratio;
+            if (m_dead_count > m_max_dead_ratio * m_container.size())
+            {
+                compact();
+            }
+        }
+
+        size_type dead_count() const noexcept
+        {
+            return m_dead_count;
+        }
+
+        void compact()
+        {
+            if (m_dead_count == 0)
+            {
+                return;
+            }
+            auto write = m_container.begin();
+            for (size_type read = 0; read < m_container.size(); ++read)
+            {
+                if (!m_dead[read])
+                {
+                    if (write != m_container.begin() + read)
+                    {
+                        *write = std::move(m_container[read]);
+                    }
+                    ++write;
+                }
+            }
+            m_container.erase(write, m_container.end());
+            m_dead.assign(m_container.size(), false);
+            m_dead_count = 0;
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(this, next_live(0));
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(this, next_live(0));
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(this, m_container.size());
+        }
+
+        const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(this, m_container.size());
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size() - m_dead_count;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+            m_dead.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            compact();
+            m_container.shrink_to_fit();
+            m_dead.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+            m_dead.clear();
+            m_dead_count = 0;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return insert_at(search(value), value);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            auto index = search(value);
+            return insert_at(index, std::move(value));
+        }
+
+        iterator insert(const_iterator, const value_type &value)
+        {
+            return insert(value).first;
+        }
+
+        iterator insert(const_iterator, value_type &&value)
+        {
+            return insert(std::move(value)).first;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator, Args &&...args)
+        {
+            return emplace(std::forward<Args>(args)...).first;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return iterator(this, kill(pos.m_index));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto index = last.m_index;
+            for (auto itr = first.m_index; itr < last.m_index; ++itr)
+            {
+                if (!m_dead[itr])
+                {
+                    m_dead[itr] = true;
+                    ++m_dead_count;
+                }
+            }
+            if (m_dead_count > m_max_dead_ratio * m_container.size())
+            {
+                index = live_before(index);
+                compact();
+            }
+            return iterator(this, index);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto find_result = find(key);
+            if (find_result == end())
+                return 0;
+            kill(find_result.m_index);
+            return 1;
+        }
+
+        void swap(lazy_sorted_set &other)
+        {
+            m_container.swap(other.m_container);
+            m_dead.swap(other.m_dead);
+            std::swap(m_dead_count, other.m_dead_count);
+            std::swap(m_max_dead_ratio, other.m_max_dead_ratio);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == cend() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            auto index = search(key);
+            if (index < m_container.size() && !m_dead[index] && !(key < m_container[index]))
+            {
+                return iterator(this, index);
+            }
+            return end();
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto index = search(key);
+            if (index < m_container.size() && !m_dead[index] && !(key < m_container[index]))
+            {
+                return const_iterator(this, index);
+            }
+            return cend();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return iterator(this, next_live(search(key)));
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return const_iterator(this, next_live(search(key)));
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            auto first = std::upper_bound(m_container.begin(), m_container.end(), key, [](const Key& k, const value_type& vt) {
+                return k < vt;
+            });
+            return iterator(this, next_live(first - m_container.begin()));
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            auto first = std::upper_bound(m_container.cbegin(), m_container.cend(), key, [](const Key& k, const value_type& vt) {
+                return k < vt;
+            });
+            return const_iterator(this, next_live(first - m_container.cbegin()));
+        }
+    };
+
+    template <class K, class A>
+    bool operator==(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+
+    template <class K, class A>
+    bool operator!=(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class K, class A>
+    bool operator<(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    }
+
+    template <class K, class A>
+    bool operator<=(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class K, class A>
+    bool operator>(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class K, class A>
+    bool operator>=(const lazy_sorted_set<K, A> &lhs, const lazy_sorted_set<K, A> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class K, class A>
+    void swap(lazy_sorted_set<K, A> &lhs, lazy_sorted_set<K, A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
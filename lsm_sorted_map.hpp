@@ -0,0 +1,798 @@
+/* lsm_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that implements a write optimized std::map as a small
+*  sel.sorted_map memtable in front of a stack of immutable sorted runs.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the lsm_sorted_map.hpp
+*  and sorted_map.hpp to your C++ project, include it and link with the platform thread library.
+*
+*    #include "lsm_sorted_map.hpp"
+*
+*  USAGE
+*
+*  Inserts and erases go to the memtable, which is never larger than lsm_policy::memtable_size, and erases of
+*  keys that may live in an older run leave a tombstone. A full memtable is frozen into a run. When fanout runs
+*  of the same size tier pile up on top of the stack they are merged into one run by a background std::thread
+*  (or at once when lsm_policy::background is false), so every element is copied O(log n) times in total.
+*  Lookups check the memtable and then the runs from the newest to the oldest, the iterators merge all levels
+*  and skip overwritten and erased keys.
+*
+*  A finished background merge is installed by the next insert or erase, wait() blocks until the merges are
+*  done and compact() merges everything into a single run without tombstones. The const members never change
+*  the levels, so concurrent readers are safe and a lookup does not invalidate iterators. Inserts return bool
+*  instead of an iterator because the element moves when the memtable is frozen, the iterators and the
+*  references from at() and operator[] are invalidated by any insert, erase, wait(), flush() or compact().
+*
+*    auto mymap = sel::lsm_sorted_map<int, int>();
+*    mymap.insert_or_assign(1, 101);
+*    mymap.erase(1);
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "sorted_set.hpp"
+#include "sorted_map.hpp"
+
+namespace sel
+{
+    struct lsm_policy
+    {
+        std::size_t memtable_size = 4096;
+        std::size_t fanout = 4;
+        bool background = true;
+    };
+
+    template <class Key, class T, class Allocator = std::allocator<std::pair<Key,T>>>
+    class lsm_sorted_map
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef const value_type &const_reference;
+
+    private:
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Key> key_allocator;
+
+        struct run
+        {
+            std::vector<value_type, Allocator> items;
+            std::vector<Key, key_allocator> erased;
+
+            size_type size() const
+            {
+                return items.size() + erased.size();
+            }
+        };
+
+        struct job_state
+        {
+            std::atomic<bool> done;
+            std::shared_ptr<const run> result;
+
+            job_state() : done(false) {}
+        };
+
+        struct level
+        {
+            const value_type *item;
+            const value_type *item_end;
+            const Key *erased;
+            const Key *erased_end;
+        };
+
+        struct key_compare
+        {
+            bool operator()(const value_type &lhs, const Key &rhs) const
+            {
+                return lhs.first < rhs;
+            }
+
+            bool operator()(const Key &lhs, const value_type &rhs) const
+            {
+                return lhs < rhs.first;
+            }
+        };
+
+        typedef std::vector<std::shared_ptr<const run>> run_stack;
+
+        sorted_map<Key, T, Allocator> m_memtable;
+        sorted_set<Key, key_allocator> m_erased;
+        run_stack m_runs;
+        size_type m_size = 0;
+        lsm_policy m_policy;
+        std::thread m_thread;
+        std::shared_ptr<job_state> m_job;
+        size_type m_job_first = 0;
+        size_type m_job_count = 0;
+
+    public:
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef typename lsm_sorted_map::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const value_type *pointer;
+            typedef const value_type &reference;
+
+        private:
+            friend class lsm_sorted_map;
+            std::vector<level> m_levels;
+            const value_type *m_current = nullptr;
+
+            void skip(const Key &key)
+            {
+                for (auto &l : m_levels)
+                {
+                    if (l.item != l.item_end && !(key < l.item->first))
+                    {
+                        ++l.item;
+                    }
+                }
+            }
+
+            // Moves to the smallest key whose newest version is an element and not a tombstone.
+            void settle()
+            {
+                for (;;)
+                {
+                    const value_type *best = nullptr;
+                    size_type best_level = 0;
+                    for (size_type i = 0; i < m_levels.size(); ++i)
+                    {
+                        auto &l = m_levels[i];
+                        if (l.item != l.item_end && (best == nullptr || l.item->first < best->first))
+                        {
+                            best = l.item;
+                            best_level = i;
+                        }
+                    }
+                    if (best == nullptr)
+                    {
+                        m_current = nullptr;
+                        return;
+                    }
+                    bool erased = false;
+                    for (size_type i = 0; i < best_level; ++i)
+                    {
+                        auto &l = m_levels[i];
+                        while (l.erased != l.erased_end && *l.erased < best->first)
+                        {
+                            ++l.erased;
+                        }
+                        erased = erased || (l.erased != l.erased_end && !(best->first < *l.erased));
+                    }
+                    if (!erased)
+                    {
+                        m_current = best;
+                        return;
+                    }
+                    skip(best->first);
+                }
+            }
+
+        public:
+            const_iterator() {}
+
+            reference operator*() const
+            {
+                return *m_current;
+            }
+
+            pointer operator->() const
+            {
+                return m_current;
+            }
+
+            const_iterator &operator++()
+            {
+                skip(m_current->first);
+                settle();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto result = *this;
+                ++(*this);
+                return result;
+            }
+
+            bool operator==(const const_iterator &other) const
+            {
+                return m_current == other.m_current;
+            }
+
+            bool operator!=(const const_iterator &other) const
+            {
+                return m_current != other.m_current;
+            }
+        };
+
+        typedef const_iterator iterator;
+
+    private:
+        template <class Vector>
+        static auto data_of(const Vector &v) -> decltype(&*v.cbegin())
+        {
+            return v.cbegin() == v.cend() ? nullptr : &*v.cbegin();
+        }
+
+        template <class Search>
+        const_iterator make_iterator(Search search) const
+        {
+            auto result = const_iterator();
+            result.m_levels.reserve(m_runs.size() + 1);
+            auto items = data_of(m_memtable);
+            auto erased = data_of(m_erased);
+            result.m_levels.push_back(search(level{items, items + m_memtable.size(), erased, erased + m_erased.size()}));
+            for (auto r = m_runs.rbegin(); r != m_runs.rend(); ++r)
+            {
+                auto &run = **r;
+                result.m_levels.push_back(search(level{run.items.data(), run.items.data() + run.items.size(), run.erased.data(), run.erased.data() + run.erased.size()}));
+            }
+            result.settle();
+            return result;
+        }
+
+        // The newest version of key, nullptr when it is missing or erased.
+        const T *lookup(const Key &key) const
+        {
+            auto found = m_memtable.find(key);
+            if (found != m_memtable.cend())
+            {
+                return &found->second;
+            }
+            if (m_erased.count(key) != 0)
+            {
+                return nullptr;
+            }
+            for (auto r = m_runs.rbegin(); r != m_runs.rend(); ++r)
+            {
+                auto &run = **r;
+                auto item = std::lower_bound(run.items.begin(), run.items.end(), key, key_compare());
+                if (item != run.items.end() && !(key < item->first))
+                {
+                    return &item->second;
+                }
+                if (std::binary_search(run.erased.begin(), run.erased.end(), key))
+                {
+                    return nullptr;
+                }
+            }
+            return nullptr;
+        }
+
+        // Merges a run with the next newer one, the newer elements and tombstones win.
+        static run merge_runs(const run &older, const run &newer, bool drop_erased)
+        {
+            auto result = run();
+            result.items.reserve(older.items.size() + newer.items.size());
+            auto o = older.items.begin();
+            auto n = newer.items.begin();
+            auto e = newer.erased.begin();
+            while (o != older.items.end() || n != newer.items.end())
+            {
+                if (n == newer.items.end() || (o != older.items.end() && o->first < n->first))
+                {
+                    while (e != newer.erased.end() && *e < o->first)
+                    {
+                        ++e;
+                    }
+                    if (e == newer.erased.end() || o->first < *e)
+                    {
+                        result.items.push_back(*o);
+                    }
+                    ++o;
+                }
+                else
+                {
+                    if (o != older.items.end() && !(n->first < o->first))
+                    {
+                        ++o;
+                    }
+                    result.items.push_back(*n);
+                    ++n;
+                }
+            }
+            if (!drop_erased)
+            {
+                auto older_erased = std::vector<Key, key_allocator>();
+                std::set_difference(older.erased.begin(), older.erased.end(), newer.items.begin(), newer.items.end(),
+                    std::back_inserter(older_erased), key_compare());
+                std::set_union(older_erased.begin(), older_erased.end(), newer.erased.begin(), newer.erased.end(),
+                    std::back_inserter(result.erased));
+            }
+            return result;
+        }
+
+        static std::shared_ptr<const run> merge_stack(const run_stack &runs, bool drop_erased)
+        {
+            auto result = std::make_shared<run>(*runs.front());
+            if (drop_erased)
+            {
+                result->erased.clear();
+            }
+            for (size_type i = 1; i < runs.size(); ++i)
+            {
+                *result = merge_runs(*result, *runs[i], drop_erased);
+            }
+            return result;
+        }
+
+        size_type tier(const run &r) const
+        {
+            size_type result = 0;
+            auto fanout = std::max<size_type>(m_policy.fanout, 2);
+            for (auto limit = std::max<size_type>(m_policy.memtable_size, 1) * fanout; r.size() >= limit; limit *= fanout)
+            {
+                ++result;
+            }
+            return result;
+        }
+
+        void install()
+        {
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+            auto first = m_runs.begin() + m_job_first;
+            first = m_runs.erase(first, first + m_job_count);
+            if (m_job->result->size() != 0)
+            {
+                m_runs.insert(first, m_job->result);
+            }
+            m_job.reset();
+        }
+
+        // Starts merging the newest runs when fanout of them share a size tier.
+        void schedule()
+        {
+            while (!m_job && !m_runs.empty())
+            {
+                size_type count = 1;
+                auto newest = tier(*m_runs.back());
+                while (count < m_runs.size() && tier(*m_runs[m_runs.size() - count - 1]) == newest)
+                {
+                    ++count;
+                }
+                if (count < std::max<size_type>(m_policy.fanout, 2))
+                {
+                    return;
+                }
+                m_job_first = m_runs.size() - count;
+                m_job_count = count;
+                m_job = std::make_shared<job_state>();
+                auto runs = run_stack(m_runs.begin() + m_job_first, m_runs.end());
+                auto job = m_job;
+                auto drop_erased = m_job_first == 0;
+                auto work = [runs, job, drop_erased]() {
+                    job->result = merge_stack(runs, drop_erased);
+                    job->done.store(true, std::memory_order_release);
+                };
+                if (m_policy.background)
+                {
+                    m_thread = std::thread(work);
+                    return;
+                }
+                work();
+                install();
+            }
+        }
+
+        void poll()
+        {
+            if (m_job && m_job->done.load(std::memory_order_acquire))
+            {
+                install();
+                schedule();
+            }
+        }
+
+        void prepare()
+        {
+            poll();
+            if (m_memtable.size() + m_erased.size() >= std::max<size_type>(m_policy.memtable_size, 1))
+            {
+                flush();
+            }
+        }
+
+        template <class V>
+        void put(const Key &key, V &&value)
+        {
+            prepare();
+            m_erased.erase(key);
+            auto found = m_memtable.find(key);
+            if (found != m_memtable.end())
+            {
+                found->second = std::forward<V>(value);
+                return;
+            }
+            m_memtable.insert(value_type(key, std::forward<V>(value)));
+        }
+
+    public:
+
+        lsm_sorted_map() {}
+
+        explicit lsm_sorted_map(const lsm_policy &policy) : m_policy(policy) {}
+
+        template <class InputIt>
+        lsm_sorted_map(InputIt first, InputIt last, const lsm_policy &policy = lsm_policy())
+            : m_policy(policy)
+        {
+            insert(first, last);
+        }
+
+        lsm_sorted_map(std::initializer_list<value_type> init, const lsm_policy &policy = lsm_policy())
+            : lsm_sorted_map(std::begin(init), std::end(init), policy)
+        {
+        }
+
+        // A copy shares the immutable runs, a merge that is still running stays with the original.
+        lsm_sorted_map(const lsm_sorted_map &other)
+            : m_memtable(other.m_memtable), m_erased(other.m_erased), m_runs(other.m_runs), m_size(other.m_size), m_policy(other.m_policy)
+        {
+        }
+
+        lsm_sorted_map(lsm_sorted_map &&other)
+        {
+            other.wait();
+            swap(other);
+        }
+
+        ~lsm_sorted_map()
+        {
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        lsm_sorted_map &operator=(const lsm_sorted_map &other)
+        {
+            if (this != &other)
+            {
+                auto copy = lsm_sorted_map(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        lsm_sorted_map &operator=(lsm_sorted_map &&other)
+        {
+            if (this != &other)
+            {
+                other.wait();
+                wait();
+                swap(other);
+            }
+            return *this;
+        }
+
+        lsm_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        const lsm_policy &policy() const noexcept
+        {
+            return m_policy;
+        }
+
+        void policy(const lsm_policy &policy)
+        {
+            wait();
+            m_policy = policy;
+            schedule();
+        }
+
+        const T &at(const Key &key) const
+        {
+            auto found = lookup(key);
+            if (found == nullptr)
+            {
+                throw std::out_of_range("failed to find key in lsm_sorted_map");
+            }
+            return *found;
+        }
+
+        // Copies the current value, or T() for a new key, into the memtable and returns a reference to it.
+        T &operator[](const Key &key)
+        {
+            auto found = lookup(key);
+            if (found == nullptr)
+            {
+                put(key, T());
+                ++m_size;
+            }
+            else if (m_memtable.find(key) == m_memtable.end())
+            {
+                put(key, T(*found));
+            }
+            return m_memtable.find(key)->second;
+        }
+
+        const_iterator begin() const
+        {
+            return make_iterator([](level l) {
+                return l;
+            });
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type run_count() const noexcept
+        {
+            return m_runs.size();
+        }
+
+        void clear()
+        {
+            wait();
+            m_memtable.clear();
+            m_erased.clear();
+            m_runs.clear();
+            m_size = 0;
+        }
+
+        bool insert(const value_type &value)
+        {
+            if (lookup(value.first) != nullptr)
+            {
+                return false;
+            }
+            put(value.first, value.second);
+            ++m_size;
+            return true;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                insert(*first);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class M>
+        bool insert_or_assign(const Key &key, M &&obj)
+        {
+            auto inserted = lookup(key) == nullptr;
+            put(key, std::forward<M>(obj));
+            m_size += inserted ? 1 : 0;
+            return inserted;
+        }
+
+        template <class... Args>
+        bool emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        size_type erase(const Key &key)
+        {
+            if (lookup(key) == nullptr)
+            {
+                return 0;
+            }
+            prepare();
+            m_memtable.erase(key);
+            if (!m_runs.empty())
+            {
+                m_erased.insert(key);
+            }
+            --m_size;
+            return 1;
+        }
+
+        void swap(lsm_sorted_map &other)
+        {
+            wait();
+            other.wait();
+            m_memtable.swap(other.m_memtable);
+            m_erased.swap(other.m_erased);
+            m_runs.swap(other.m_runs);
+            std::swap(m_size, other.m_size);
+            std::swap(m_policy, other.m_policy);
+        }
+
+        // Freezes the memtable into the newest run.
+        void flush()
+        {
+            if (m_memtable.empty() && m_erased.empty())
+            {
+                return;
+            }
+            auto frozen = std::make_shared<run>();
+            frozen->items.assign(std::make_move_iterator(m_memtable.begin()), std::make_move_iterator(m_memtable.end()));
+            frozen->erased.assign(m_erased.cbegin(), m_erased.cend());
+            if (m_runs.empty())
+            {
+                frozen->erased.clear();
+            }
+            m_memtable.clear();
+            m_erased.clear();
+            m_runs.push_back(frozen);
+            schedule();
+        }
+
+        // Blocks until the background merges are installed.
+        void wait()
+        {
+            while (m_job)
+            {
+                install();
+                schedule();
+            }
+        }
+
+        // Flushes the memtable and merges all runs into one without tombstones.
+        void compact()
+        {
+            wait();
+            flush();
+            wait();
+            if (m_runs.size() > 1 || (m_runs.size() == 1 && !m_runs.front()->erased.empty()))
+            {
+                auto merged = merge_stack(m_runs, true);
+                m_runs.assign(1, merged);
+            }
+        }
+
+        size_type count(const Key &key) const
+        {
+            return lookup(key) == nullptr ? 0 : 1;
+        }
+
+        bool contains(const Key &key) const
+        {
+            return lookup(key) != nullptr;
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto result = lower_bound(key);
+            if (result != end() && !(key < result->first))
+            {
+                return result;
+            }
+            return end();
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return make_iterator([&key](level l) {
+                l.item = std::lower_bound(l.item, l.item_end, key, key_compare());
+                l.erased = std::lower_bound(l.erased, l.erased_end, key);
+                return l;
+            });
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return make_iterator([&key](level l) {
+                l.item = std::upper_bound(l.item, l.item_end, key, key_compare());
+                l.erased = std::upper_bound(l.erased, l.erased_end, key);
+                return l;
+            });
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+    };
+
+    template <class K, class V, class A>
+    bool operator==(const lsm_sorted_map<K,V,A> &lhs, const lsm_sorted_map<K,V,A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class K, class V, class A>
+    bool operator!=(const lsm_sorted_map<K,V,A> &lhs, const lsm_sorted_map<K,V,A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class K, class V, class A>
+    void swap(lsm_sorted_map<K,V,A> &lhs, lsm_sorted_map<K,V,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
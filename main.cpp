@@ -3,9 +3,42 @@
 #include <set>
 #include <map>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <memory>
 
 #include "sorted_set.hpp"
 #include "sorted_map.hpp"
+#include "lazy_sorted_set.hpp"
+#include "lazy_sorted_map.hpp"
+#include "small_sorted_set.hpp"
+#include "small_sorted_map.hpp"
+#include "adaptive_sorted_map.hpp"
+#include "sorted_multiset.hpp"
+#include "sorted_multimap.hpp"
+#include "augmented_sorted_map.hpp"
+#include "gap_sorted_set.hpp"
+#include "gap_sorted_map.hpp"
+#if __cplusplus >= 201402L
+#include "static_sorted_set.hpp"
+#include "static_sorted_map.hpp"
+#endif
+#include "frozen_sorted_map.hpp"
+#include "radix_sorted_set.hpp"
+#if __cplusplus >= 201703L
+#include "string_sorted_map.hpp"
+#endif
+#include "sorted_parallel.hpp"
+#include "lsm_sorted_map.hpp"
+#include "sorted_trace.hpp"
+#include "roaring_sorted_set.hpp"
+#include "sorted_diff.hpp"
+#include "window_sorted_map.hpp"
+#include "slab_sorted_map.hpp"
 
 void compare_with_std_set();
 void compare_with_std_map();
@@ -103,6 +136,87 @@ void compare_map_assigns()
     std::cout << " OK\n";
 }
 
+void compare_map_capacity()
+{
+    std::cout << "compare_map_capacity";
+
+    {
+        auto sorted_map = sel::sorted_map<int,int>();
+        sorted_map.reserve(100);
+        assert(sorted_map.capacity() >= 100);
+
+        sorted_map.insert({{5, 505}, {3, 303}, {1, 101}});
+        sorted_map.shrink_to_fit();
+        assert(sorted_map.capacity() >= sorted_map.size());
+
+        sorted_map.growth_factor(4.0f);
+        sorted_map.emplace(2, 202);
+        assert(sorted_map.capacity() >= 12);
+        assert_map_equal(std::map<int,int>({{1, 101}, {2, 202}, {3, 303}, {5, 505}}), sorted_map);
+    }
+
+    {
+        auto sorted_org_map = sel::sorted_map<std::string, int>({{"zero", 0}, {"one", 1}, {"two", 2}, {"three", 3}});
+        auto sorted_map = sel::sorted_map<std::string, int>();
+        sorted_map = sorted_org_map;
+        assert(sorted_map == sorted_org_map);
+
+        auto sorted_other_map = sel::sorted_map<std::string, int>({{"four", 4}});
+        swap(sorted_map, sorted_other_map);
+        assert(sorted_map.size() == 1 && sorted_other_map == sorted_org_map);
+
+        auto alloc = sorted_org_map.get_allocator();
+        auto sorted_moved_map = sel::sorted_map<std::string, int>(std::move(sorted_org_map), alloc);
+        assert(sorted_moved_map == sorted_other_map);
+    }
+
+#if __cplusplus >= 201703L
+    {
+        char buffer[1024];
+        auto resource = std::pmr::monotonic_buffer_resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        auto sorted_map = sel::pmr::sorted_map<int,int>(&resource);
+        sorted_map.reserve(32);
+        sorted_map.insert({{5, 505}, {3, 303}, {5, 505}, {2, 202}, {4, 404}});
+
+        assert(sorted_map.size() == 4 && sorted_map.at(4) == 404);
+        assert(sorted_map.get_allocator().resource() == &resource);
+    }
+#endif
+
+    std::cout << " OK\n";
+}
+
+void compare_map_stats()
+{
+    std::cout << "compare_map_stats";
+
+    {
+        auto sorted_map = sel::sorted_map<int, int, std::allocator<std::pair<int,int>>, sel::container_stats>();
+        sorted_map.insert({{1, 101}, {2, 202}, {3, 303}, {5, 505}, {6, 606}});
+        sorted_map.reset_stats();
+
+        assert(!sorted_map.insert(std::make_pair(3, 333)).second);
+        assert(sorted_map.at(3) == 303);
+        assert(sorted_map.stats().elements_moved == 0);
+
+        sorted_map.emplace_hint(sorted_map.find(5), 4, 404);
+        assert(sorted_map.stats().hint_hits == 1);
+        assert(sorted_map.stats().elements_moved == 2);
+        assert(sorted_map.stats().bytes_shifted == 2 * sizeof(std::pair<int,int>));
+
+        sorted_map.emplace_hint(sorted_map.begin(), 7, 707);
+        assert(sorted_map.stats().hint_misses == 1);
+
+        auto keys = std::vector<int>({1, 2});
+        sorted_map.erase_keys(keys.begin(), keys.end());
+        assert(sorted_map.stats().elements_moved == 2 + 5);
+        assert_map_equal(std::map<int,int>({{3, 303}, {4, 404}, {5, 505}, {6, 606}, {7, 707}}),
+                         sel::sorted_map<int,int>(sorted_map.begin(), sorted_map.end()));
+    }
+
+    std::cout << " OK\n";
+}
+
 void compare_map_element_access()
 {
     std::cout << "compare_map_element_access";
@@ -173,6 +287,97 @@ void compare_map_element_access()
     std::cout << " OK\n";
 }
 
+void compare_set_capacity()
+{
+    std::cout << "compare_set_capacity";
+
+    {
+        auto sorted_set = sel::sorted_set<int>();
+        sorted_set.reserve(100);
+        assert(sorted_set.capacity() >= 100);
+
+        sorted_set.insert({5, 3, 1});
+        sorted_set.shrink_to_fit();
+        assert(sorted_set.capacity() >= sorted_set.size());
+
+        sorted_set.growth_factor(4.0f);
+        sorted_set.insert(2);
+        assert(sorted_set.capacity() >= 12);
+        assert_set_equal(std::set<int>({1, 2, 3, 5}), sorted_set);
+    }
+
+    {
+        auto sorted_org_set = sel::sorted_set<std::string>({"zero", "one", "two", "three"});
+        auto sorted_set = sel::sorted_set<std::string>();
+        sorted_set = sorted_org_set;
+        assert(sorted_set == sorted_org_set);
+
+        auto sorted_other_set = sel::sorted_set<std::string>({"four"});
+        swap(sorted_set, sorted_other_set);
+        assert(sorted_set.size() == 1 && sorted_other_set == sorted_org_set);
+
+        auto alloc = sorted_org_set.get_allocator();
+        auto sorted_moved_set = sel::sorted_set<std::string>(std::move(sorted_org_set), alloc);
+        assert(sorted_moved_set == sorted_other_set);
+    }
+
+#if __cplusplus >= 201703L
+    {
+        char buffer[1024];
+        auto resource = std::pmr::monotonic_buffer_resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        auto sorted_set = sel::pmr::sorted_set<int>(&resource);
+        sorted_set.reserve(64);
+        sorted_set.insert({5, 3, 5, 3, 2, 4});
+
+        assert(std::vector<int>(sorted_set.cbegin(), sorted_set.cend()) == std::vector<int>({2, 3, 4, 5}));
+        assert(sorted_set.get_allocator().resource() == &resource);
+    }
+#endif
+
+    std::cout << " OK\n";
+}
+
+void compare_set_stats()
+{
+    std::cout << "compare_set_stats";
+
+    {
+        auto sorted_set = sel::sorted_set<int, std::allocator<int>, sel::container_stats>();
+        sorted_set.reserve(8);
+        sorted_set.insert({1, 2, 3, 5, 6});
+        sorted_set.reset_stats();
+
+        sorted_set.insert(4);
+        assert(sorted_set.stats().searches == 1);
+        assert(sorted_set.stats().comparisons > 0);
+        assert(sorted_set.stats().elements_moved == 2);
+        assert(sorted_set.stats().bytes_shifted == 2 * sizeof(int));
+        assert(sorted_set.stats().reallocations == 0);
+
+        sorted_set.insert(sorted_set.find(8), 7);
+        sorted_set.insert(sorted_set.begin(), 9);
+        assert(sorted_set.stats().hint_hits == 1 && sorted_set.stats().hint_misses == 1);
+
+        sorted_set.insert({10, 11});
+        assert(sorted_set.stats().reallocations == 1);
+
+        sorted_set.erase(1);
+        assert(sorted_set.stats().elements_moved == 2 + 9);
+        assert(sorted_set.stats().max_search_depth <= 4);
+
+        sorted_set.reset_stats();
+        assert(sorted_set.stats().comparisons == 0 && sorted_set.stats().searches == 0);
+        assert_set_equal(std::set<int>({2, 3, 4, 5, 6, 7, 9, 10, 11}), sel::sorted_set<int>(sorted_set.begin(), sorted_set.end()));
+    }
+
+    {
+        assert(sizeof(sel::sorted_set<int>) == sizeof(sel::sorted_set<int, std::allocator<int>, sel::no_stats>));
+        assert(sizeof(sel::detail::stats_and_growth<sel::no_stats>) == sizeof(float));
+    }
+
+    std::cout << " OK\n";
+}
+
 void compare_set_insert()
 {
     std::cout << "compare_set_insert";
@@ -432,6 +637,40 @@ void compare_set_erase()
         assert_set_equal(std_set, sorted_set);
     }
 
+    {
+        auto std_set = std::set<int>();
+        auto sorted_set = sel::sorted_set<int>();
+        for (int i = 0; i < 1000; ++i)
+        {
+            std_set.insert(i);
+            sorted_set.insert(i);
+        }
+
+        for (auto itr = std_set.begin(); itr != std_set.end();)
+        {
+            itr = (*itr % 3 == 0) ? std_set.erase(itr) : std::next(itr);
+        }
+        auto erased = sel::erase_if(sorted_set, [](int v) { return v % 3 == 0; });
+
+        assert(erased == 334);
+        assert_set_equal(std_set, sorted_set);
+    }
+
+    {
+        auto std_set = std::set<int>({5, 2, 4, 1, 8, 3, 9, 7});
+        auto sorted_set = sel::sorted_set<int>({5, 2, 4, 1, 8, 3, 9, 7});
+        auto keys = std::vector<int>({9, 2, 10, 4, 2, 0});
+
+        for (auto key : keys)
+        {
+            std_set.erase(key);
+        }
+        auto erased = sorted_set.erase_keys(keys.begin(), keys.end());
+
+        assert(erased == 3);
+        assert_set_equal(std_set, sorted_set);
+    }
+
     std::cout << " OK\n";
 }
 
@@ -465,6 +704,554 @@ void compare_map_erase()
         assert_map_equal(std_map, sorted_map);
     }
 
+    {
+        auto std_map = std::map<int,int>();
+        auto sorted_map = sel::sorted_map<int,int>();
+        for (int i = 0; i < 1000; ++i)
+        {
+            std_map[i] = i * 10;
+            sorted_map[i] = i * 10;
+        }
+
+        for (auto itr = std_map.begin(); itr != std_map.end();)
+        {
+            itr = (itr->second % 30 == 0) ? std_map.erase(itr) : std::next(itr);
+        }
+        auto erased = sel::erase_if(sorted_map, [](const std::pair<int,int>& vt) { return vt.second % 30 == 0; });
+
+        assert(erased == 334);
+        assert_map_equal(std_map, sorted_map);
+    }
+
+    {
+        auto std_map = std::map<int,int>({{5, 505}, {2, 202}, {4, 404}, {1, 101}, {8, 808}, {3, 303}});
+        auto sorted_map = sel::sorted_map<int,int>({{5, 505}, {2, 202}, {4, 404}, {1, 101}, {8, 808}, {3, 303}});
+        auto keys = std::vector<int>({1, 3, 5, 7});
+
+        for (auto key : keys)
+        {
+            std_map.erase(key);
+        }
+        auto erased = sorted_map.erase_keys(keys.begin(), keys.end());
+
+        assert(erased == 3);
+        assert_map_equal(std_map, sorted_map);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_set_merge()
+{
+    std::cout << "compare_set_merge";
+
+    {
+        auto std_dst = std::set<int>({1, 3, 5, 7, 9});
+        auto std_src = std::set<int>({2, 3, 4, 9, 11});
+        auto sel_dst = sel::sorted_set<int>({1, 3, 5, 7, 9});
+        auto sel_src = sel::sorted_set<int>({2, 3, 4, 9, 11});
+
+        for (auto itr = std_src.begin(); itr != std_src.end();)
+        {
+            itr = std_dst.insert(*itr).second ? std_src.erase(itr) : std::next(itr);
+        }
+        sel_dst.merge(sel_src);
+        assert(std::vector<int>(std_dst.begin(), std_dst.end()) == std::vector<int>(sel_dst.cbegin(), sel_dst.cend()));
+        assert(std::vector<int>(std_src.begin(), std_src.end()) == std::vector<int>(sel_src.cbegin(), sel_src.cend()));
+
+        auto upper = sel_dst.split(5);
+        assert(sel_dst == sel::sorted_set<int>({1, 2, 3, 4}));
+        assert(upper == sel::sorted_set<int>({5, 7, 9, 11}));
+        assert(sel_dst.split(100).empty() && sel_dst.size() == 4);
+
+        sel_dst.join(std::move(upper));
+        assert(upper.empty() && std::vector<int>(std_dst.begin(), std_dst.end()) == std::vector<int>(sel_dst.cbegin(), sel_dst.cend()));
+
+        auto empty_set = sel::sorted_set<int>();
+        empty_set.join(sel::sorted_set<int>({4, 2}));
+        empty_set.join(sel::sorted_set<int>({1, 3, 4}));
+        assert(empty_set == sel::sorted_set<int>({1, 2, 3, 4}));
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_map_merge()
+{
+    std::cout << "compare_map_merge";
+
+    {
+        auto std_dst = std::map<int,int>();
+        auto std_src = std::map<int,int>();
+        auto sel_dst = sel::sorted_map<int,int>();
+        auto sel_src = sel::sorted_map<int,int>();
+        for (int i = 0; i < 500; ++i)
+        {
+            std_dst[(i * 7) % 311] = i;
+            sel_dst[(i * 7) % 311] = i;
+            std_src[(i * 13) % 401] = -i;
+            sel_src[(i * 13) % 401] = -i;
+        }
+
+        for (auto itr = std_src.begin(); itr != std_src.end();)
+        {
+            itr = std_dst.insert(*itr).second ? std_src.erase(itr) : std::next(itr);
+        }
+        sel_dst.merge(sel_src);
+        auto left = std::vector<std::pair<int,int>>(std_dst.cbegin(), std_dst.cend());
+        auto right = std::vector<std::pair<int,int>>(sel_dst.cbegin(), sel_dst.cend());
+        assert(left == right);
+        left = std::vector<std::pair<int,int>>(std_src.cbegin(), std_src.cend());
+        right = std::vector<std::pair<int,int>>(sel_src.cbegin(), sel_src.cend());
+        assert(left == right);
+
+        auto upper = sel_dst.split(200);
+        assert(sel_dst.size() == static_cast<size_t>(std::distance(std_dst.begin(), std_dst.lower_bound(200))));
+        assert(upper.cbegin()->first == std_dst.lower_bound(200)->first);
+        sel_dst.join(std::move(upper));
+        right = std::vector<std::pair<int,int>>(sel_dst.cbegin(), sel_dst.cend());
+        left = std::vector<std::pair<int,int>>(std_dst.cbegin(), std_dst.cend());
+        assert(left == right);
+
+        auto overlap = sel::sorted_map<int,int>({{1, 101}, {2, 202}});
+        overlap.join(sel::sorted_map<int,int>({{2, 0}, {3, 303}}));
+        assert(overlap.size() == 3 && overlap.at(2) == 202 && overlap.at(3) == 303);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_map_apply_batch()
+{
+    std::cout << "compare_map_apply_batch";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto sel_map = sel::sorted_map<int,int>();
+        for (int i = 0; i < 2000; i += 2)
+        {
+            std_map[i] = i;
+            sel_map.insert(sel_map.end(), std::make_pair(i, i));
+        }
+
+        for (int round = 0; round < 20; ++round)
+        {
+            auto batch = std::vector<sel::batch_mutation<int,int>>();
+            for (int i = 0; i < 300; ++i)
+            {
+                auto key = (i * 7919 + round * 104729) % 2500;
+                auto op = (i + round) % 3 == 0 ? sel::batch_op::erase : sel::batch_op::upsert;
+                batch.push_back(sel::batch_mutation<int,int>{key, op, round * 1000 + i});
+            }
+            if (round % 2 == 0)
+            {
+                std::sort(batch.begin(), batch.end(), [](const sel::batch_mutation<int,int> &lhs, const sel::batch_mutation<int,int> &rhs) {
+                    return lhs.key < rhs.key;
+                });
+            }
+
+            auto last_op = std::map<int,sel::batch_mutation<int,int>>();
+            for (auto &mutation : batch)
+            {
+                last_op.erase(mutation.key);
+                last_op.insert(std::make_pair(mutation.key, mutation));
+            }
+            auto expected = sel::batch_result();
+            for (auto &entry : last_op)
+            {
+                bool present = std_map.count(entry.first) != 0;
+                if (entry.second.op == sel::batch_op::erase)
+                {
+                    expected.erased += std_map.erase(entry.first);
+                }
+                else
+                {
+                    ++(present ? expected.updated : expected.inserted);
+                    std_map[entry.first] = entry.second.value;
+                }
+            }
+
+            auto result = sel_map.apply_batch(batch.begin(), batch.end());
+            assert(result.inserted == expected.inserted && result.updated == expected.updated && result.erased == expected.erased);
+            auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+            auto right = std::vector<std::pair<int,int>>(sel_map.cbegin(), sel_map.cend());
+            assert(left == right);
+        }
+    }
+
+    {
+        auto sel_map = sel::sorted_map<std::string,std::string>();
+        auto batch = std::vector<sel::batch_mutation<std::string,std::string>>();
+        batch.push_back(sel::batch_mutation<std::string,std::string>{"b", sel::batch_op::upsert, "1"});
+        batch.push_back(sel::batch_mutation<std::string,std::string>{"a", sel::batch_op::upsert, "2"});
+        batch.push_back(sel::batch_mutation<std::string,std::string>{"b", sel::batch_op::erase, ""});
+        batch.push_back(sel::batch_mutation<std::string,std::string>{"c", sel::batch_op::erase, ""});
+        auto result = sel_map.apply_batch(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        assert(result.inserted == 1 && result.updated == 0 && result.erased == 0);
+        assert(sel_map.size() == 1 && sel_map.at("a") == "2");
+        result = sel_map.apply_batch(batch.begin(), batch.begin());
+        assert(result.inserted == 0 && sel_map.size() == 1);
+    }
+
+    std::cout << " OK\n";
+}
+
+template <class V>
+struct diff_recorder
+{
+    std::vector<V> *m_added;
+    std::vector<V> *m_removed;
+    std::vector<std::pair<V,V>> *m_changed;
+
+    void added(const V &v)
+    {
+        m_added->push_back(v);
+    }
+
+    void removed(const V &v)
+    {
+        m_removed->push_back(v);
+    }
+
+    void changed(const V &old, const V &current)
+    {
+        m_changed->push_back(std::make_pair(old, current));
+    }
+};
+
+template <class V>
+struct set_diff_recorder
+{
+    std::vector<V> *m_added;
+    std::vector<V> *m_removed;
+
+    void added(const V &v)
+    {
+        m_added->push_back(v);
+    }
+
+    void removed(const V &v)
+    {
+        m_removed->push_back(v);
+    }
+};
+
+template <class Key, class T>
+void check_map_diff(const std::map<Key,T> &std_old, const std::map<Key,T> &std_new, const sel::sorted_map<Key,T> &sel_old, const sel::sorted_map<Key,T> &sel_new)
+{
+    typedef std::pair<Key,T> value_type;
+    auto expected_added = std::vector<value_type>();
+    auto expected_removed = std::vector<value_type>();
+    auto expected_changed = std::vector<std::pair<value_type,value_type>>();
+    for (auto &entry : std_new)
+    {
+        auto found = std_old.find(entry.first);
+        if (found == std_old.end())
+        {
+            expected_added.push_back(entry);
+        }
+        else if (!(found->second == entry.second))
+        {
+            expected_changed.push_back(std::make_pair(value_type(*found), value_type(entry)));
+        }
+    }
+    for (auto &entry : std_old)
+    {
+        if (std_new.count(entry.first) == 0)
+        {
+            expected_removed.push_back(entry);
+        }
+    }
+
+    auto added = std::vector<value_type>();
+    auto removed = std::vector<value_type>();
+    auto changed = std::vector<std::pair<value_type,value_type>>();
+    auto result = sel::diff(sel_old, sel_new, diff_recorder<value_type>{&added, &removed, &changed});
+    assert(added == expected_added && removed == expected_removed && changed == expected_changed);
+    assert(result.added == added.size() && result.removed == removed.size() && result.changed == changed.size());
+}
+
+void compare_map_diff()
+{
+    std::cout << "compare_map_diff";
+
+    {
+        auto std_old = std::map<int,int>();
+        auto sel_old = sel::sorted_map<int,int>();
+        for (int i = 0; i < 20000; ++i)
+        {
+            std_old[i * 3] = i;
+            sel_old.insert(sel_old.end(), std::make_pair(i * 3, i));
+        }
+        auto std_new = std_old;
+        auto sel_new = sel_old;
+        check_map_diff(std_old, std_new, sel_old, sel_new);
+
+        for (int i = 0; i < 60; ++i)
+        {
+            auto key = (i * 7919) % 60000;
+            if (i % 3 == 0)
+            {
+                std_new.erase(key);
+                sel_new.erase(key);
+            }
+            else if (i % 3 == 1)
+            {
+                std_new[key] = -i;
+                sel_new[key] = -i;
+            }
+            else
+            {
+                std_new[key + 1] = i;
+                sel_new[key + 1] = i;
+            }
+        }
+        check_map_diff(std_old, std_new, sel_old, sel_new);
+        check_map_diff(std_new, std_old, sel_new, sel_old);
+        check_map_diff(std::map<int,int>(), std_new, sel::sorted_map<int,int>(), sel_new);
+        check_map_diff(std_old, std::map<int,int>(), sel_old, sel::sorted_map<int,int>());
+    }
+
+    {
+        auto std_old = std::map<int,std::string>();
+        auto sel_old = sel::sorted_map<int,std::string>();
+        auto std_new = std::map<int,std::string>();
+        auto sel_new = sel::sorted_map<int,std::string>();
+        for (int i = 0; i < 500; ++i)
+        {
+            auto old_key = (i * 13) % 701;
+            auto new_key = (i * 17) % 701;
+            std_old[old_key] = std::to_string(old_key);
+            sel_old[old_key] = std::to_string(old_key);
+            std_new[new_key] = std::to_string(new_key % 5 == 0 ? -new_key : new_key);
+            sel_new[new_key] = std::to_string(new_key % 5 == 0 ? -new_key : new_key);
+        }
+        check_map_diff(std_old, std_new, sel_old, sel_new);
+    }
+
+    {
+        auto sel_old = sel::sorted_set<int>({1, 2, 3, 5, 8, 13});
+        auto sel_new = sel::sorted_set<int>({2, 3, 4, 5, 13, 21});
+        auto added = std::vector<int>();
+        auto removed = std::vector<int>();
+        auto result = sel::diff(sel_old, sel_new, set_diff_recorder<int>{&added, &removed});
+        assert(added == std::vector<int>({4, 21}) && removed == std::vector<int>({1, 8}));
+        assert(result.added == 2 && result.removed == 2 && result.changed == 0);
+        result = sel::diff(sel_old.span_between(2, 5), sel_new.span_between(2, 5), set_diff_recorder<int>{&added, &removed});
+        assert(result.added == 1 && result.removed == 0);
+    }
+
+    {
+        typedef std::pair<int,int> value_type;
+        auto sel_old = sel::sorted_set<value_type>({{1, 1}, {1, 2}, {2, 0}});
+        auto sel_new = sel::sorted_set<value_type>({{1, 2}, {2, 0}});
+        auto added = std::vector<value_type>();
+        auto removed = std::vector<value_type>();
+        auto result = sel::diff(sel_old, sel_new, set_diff_recorder<value_type>{&added, &removed});
+        assert(added.empty() && removed == std::vector<value_type>(1, value_type(1, 1)));
+        assert(result.added == 0 && result.removed == 1 && result.changed == 0);
+
+        auto map_old = sel::sorted_map<int,int>({{1, 1}, {2, 0}});
+        auto map_new = sel::sorted_map<int,int>({{1, 2}, {2, 0}});
+        auto changed = std::vector<std::pair<value_type, value_type>>();
+        result = sel::diff_map(map_old.as_span(), map_new.as_span(), diff_recorder<value_type>{&added, &removed, &changed});
+        assert(result.changed == 1 && changed.front().second == value_type(1, 2));
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_set_cursor()
+{
+    std::cout << "compare_set_cursor";
+
+    {
+        auto std_set = std::set<int>();
+        auto sorted_set = sel::sorted_set<int>();
+        for (int i = 0; i < 5000; ++i)
+        {
+            std_set.insert(i * 3);
+            sorted_set.insert(i * 3);
+        }
+
+        auto cursor = sorted_set.make_cursor();
+        int key = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            key += (i * 7919) % 41 - 20;
+            if (i % 1000 == 0)
+            {
+                key = (i * 104729) % 16000 - 500;
+            }
+            assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(sorted_set.begin(), cursor.lower_bound(key)));
+            assert(cursor.position() == sorted_set.lower_bound(key));
+            assert(std::distance(std_set.begin(), std_set.upper_bound(key)) == std::distance(sorted_set.begin(), cursor.upper_bound(key)));
+            assert(cursor.seek(key) == (std_set.count(key) == 1));
+            auto found = cursor.find(key);
+            assert(found == sorted_set.find(key));
+        }
+
+        sorted_set.erase(sorted_set.lower_bound(6000), sorted_set.end());
+        assert(cursor.find(9000) == sorted_set.end() && cursor.index() == sorted_set.size());
+        assert(*cursor.lower_bound(3) == 3 && cursor.index() == 1);
+    }
+
+    {
+        auto stats_set = sel::sorted_set<int, std::allocator<int>, sel::container_stats>();
+        for (int i = 0; i < 1 << 16; ++i)
+        {
+            stats_set.insert(stats_set.cend(), i);
+        }
+        stats_set.reset_stats();
+        const auto &const_set = stats_set;
+        auto cursor = const_set.make_cursor();
+        for (int key = 0; key < 1 << 16; key += 2)
+        {
+            assert(*cursor.find(key) == key);
+        }
+        assert(stats_set.stats().average_search_depth() < 6.0);
+
+        auto empty_set = sel::sorted_set<int>();
+        auto empty_cursor = empty_set.make_cursor();
+        assert(empty_cursor.find(1) == empty_set.end() && empty_cursor.lower_bound(1) == empty_set.end());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_map_cursor()
+{
+    std::cout << "compare_map_cursor";
+
+    {
+        auto std_map = std::map<int, int>();
+        auto sorted_map = sel::sorted_map<int, int>();
+        for (int i = 0; i < 3000; ++i)
+        {
+            std_map[(i * 7919) % 9001] = i;
+            sorted_map[(i * 7919) % 9001] = i;
+        }
+
+        auto cursor = sorted_map.make_cursor();
+        for (int key = 9100; key > -100; key -= 7)
+        {
+            assert(std::distance(std_map.begin(), std_map.lower_bound(key)) == std::distance(sorted_map.begin(), cursor.lower_bound(key)));
+            assert(std::distance(std_map.begin(), std_map.upper_bound(key)) == std::distance(sorted_map.begin(), cursor.upper_bound(key)));
+            auto found = cursor.find(key);
+            assert(std_map.count(key) == 0 ? found == sorted_map.end() : found->second == std_map[key]);
+        }
+
+        cursor.reset();
+        for (auto &pair : std_map)
+        {
+            auto found = cursor.find(pair.first);
+            found->second += 1;
+            assert(sorted_map.at(pair.first) == pair.second + 1);
+        }
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_set_span()
+{
+    std::cout << "compare_set_span";
+
+    {
+        auto std_set = std::set<float>();
+        auto sorted_set = sel::sorted_set<float>();
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto key = static_cast<float>((i * 7919) % 1009) / 4.0f;
+            std_set.insert(key);
+            sorted_set.insert(key);
+        }
+
+        auto all = sorted_set.as_span();
+        assert(all.data() == sorted_set.data() && all.data() == &*sorted_set.cbegin() && all.size() == sorted_set.size());
+        assert(std::vector<float>(all.begin(), all.end()) == std::vector<float>(std_set.begin(), std_set.end()));
+
+        for (float lo = -1.0f; lo < 260.0f; lo += 13.5f)
+        {
+            auto between = sorted_set.span_between(lo, lo + 20.0f);
+            auto expected = std::vector<float>(std_set.lower_bound(lo), std_set.upper_bound(lo + 20.0f));
+            assert(std::vector<float>(between.begin(), between.end()) == expected);
+            assert(between.empty() || between.data() == &*sorted_set.lower_bound(lo));
+        }
+        assert(sorted_set.span_between(10.0f, 5.0f).empty());
+
+        std::size_t blocks = 0;
+        std::size_t visited = 0;
+        float sum = 0.0f;
+        sel::visit_blocks(all, 64, [&](sel::span<float> block) {
+            assert(block.size() <= 64 && block.data() == all.data() + visited);
+            ++blocks;
+            visited += block.size();
+            for (auto key : block)
+            {
+                sum += key;
+            }
+        });
+        assert(visited == all.size() && blocks == (all.size() + 63) / 64);
+        assert(sum == std::accumulate(all.begin(), all.end(), 0.0f));
+
+        auto empty_set = sel::sorted_set<float>();
+        assert(empty_set.as_span().empty() && empty_set.span_between(0.0f, 1.0f).empty());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_map_span()
+{
+    std::cout << "compare_map_span";
+
+    {
+        auto std_map = std::map<int, double>();
+        auto sorted_map = sel::sorted_map<int, double>();
+        for (int i = 0; i < 1000; ++i)
+        {
+            int key = (i * 7919) % 1009;
+            std_map[key] = key * 0.5;
+            sorted_map[key] = key * 0.5;
+        }
+
+        auto pairs = sorted_map.as_span();
+        assert(pairs.data() == sorted_map.data() && pairs.size() == std_map.size());
+
+        auto keys = sorted_map.keys_view();
+        auto values = sorted_map.values_view();
+        assert(keys.size() == std_map.size() && values.size() == std_map.size());
+        assert(keys.stride() == sizeof(std::pair<int, double>) && keys.data() == &sorted_map.data()->first);
+        auto std_keys = std::vector<int>();
+        auto std_values = std::vector<double>();
+        for (auto &pair : std_map)
+        {
+            std_keys.push_back(pair.first);
+            std_values.push_back(pair.second);
+        }
+        assert(std::vector<int>(keys.begin(), keys.end()) == std_keys);
+        assert(std::vector<double>(values.begin(), values.end()) == std_values);
+        assert(keys.end() - keys.begin() == static_cast<std::ptrdiff_t>(keys.size()) && keys.begin()[10] == keys[10]);
+        assert(std::lower_bound(keys.begin(), keys.end(), 500) - keys.begin() == std::distance(std_map.begin(), std_map.lower_bound(500)));
+
+        auto between = sorted_map.span_between(100, 200);
+        assert(static_cast<std::ptrdiff_t>(between.size()) == std::distance(std_map.lower_bound(100), std_map.upper_bound(200)));
+        assert(between.front().first == std_map.lower_bound(100)->first && between.back().first == std::prev(std_map.upper_bound(200))->first);
+
+        double total = 0.0;
+        sel::visit_blocks(values.subspan(100, 300), 32, [&total](sel::strided_span<double> block) {
+            for (auto value : block)
+            {
+                total += value;
+            }
+        });
+        assert(total == std::accumulate(std_values.begin() + 100, std_values.begin() + 400, 0.0));
+
+        auto empty_map = sel::sorted_map<int, double>();
+        assert(empty_map.keys_view().empty() && empty_map.values_view().begin() == empty_map.values_view().end());
+    }
+
     std::cout << " OK\n";
 }
 
@@ -583,25 +1370,1688 @@ void compare_map_operators()
     std::cout << " OK\n";
 }
 
+void compare_lazy_set()
+{
+    std::cout << "compare_lazy_set";
+
+    {
+        auto std_set = std::set<int>();
+        auto lazy_set = sel::lazy_sorted_set<int>();
+        lazy_set.max_dead_ratio(0.5f);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = (i * 7919) % 211;
+            if (i % 3 == 0)
+            {
+                assert(std_set.erase(key) == lazy_set.erase(key));
+            }
+            else
+            {
+                assert(std_set.insert(key).second == lazy_set.insert(key).second);
+            }
+            assert(std_set.size() == lazy_set.size());
+        }
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(lazy_set.cbegin(), lazy_set.cend()));
+        assert(std::vector<int>(std_set.rbegin(), std_set.rend()) == std::vector<int>(lazy_set.crbegin(), lazy_set.crend()));
+
+        for (int key = -1; key < 213; ++key)
+        {
+            assert(std_set.count(key) == lazy_set.count(key));
+            assert((std_set.lower_bound(key) == std_set.end()) == (lazy_set.lower_bound(key) == lazy_set.end()));
+            assert(std_set.upper_bound(key) == std_set.end() || *std_set.upper_bound(key) == *lazy_set.upper_bound(key));
+        }
+    }
+
+    {
+        auto lazy_set = sel::lazy_sorted_set<int>({1, 2, 3, 4, 5, 6, 7, 8});
+        lazy_set.max_dead_ratio(1.0f);
+
+        auto next = lazy_set.erase(lazy_set.find(3));
+        assert(*next == 4);
+        lazy_set.erase(lazy_set.find(4), lazy_set.find(7));
+        assert(lazy_set.dead_count() == 4);
+        assert(lazy_set.insert(5).second);
+        assert(lazy_set.dead_count() == 3);
+
+        lazy_set.compact();
+        assert(lazy_set.dead_count() == 0);
+        assert(std::vector<int>(lazy_set.cbegin(), lazy_set.cend()) == std::vector<int>({1, 2, 5, 7, 8}));
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_lazy_map()
+{
+    std::cout << "compare_lazy_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto lazy_map = sel::lazy_sorted_map<int,int>();
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = (i * 7919) % 211;
+            if (i % 3 == 0)
+            {
+                assert(std_map.erase(key) == lazy_map.erase(key));
+            }
+            else
+            {
+                std_map[key] += i;
+                lazy_map[key] += i;
+            }
+        }
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(lazy_map.cbegin(), lazy_map.cend());
+        assert(left == right);
+        assert(std_map.size() == lazy_map.size());
+
+        for (int key = -1; key < 213; ++key)
+        {
+            auto std_itr = std_map.find(key);
+            auto lazy_itr = lazy_map.find(key);
+            assert((std_itr == std_map.end()) == (lazy_itr == lazy_map.end()));
+            assert(std_itr == std_map.end() || std_itr->second == lazy_map.at(key));
+        }
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_small_set()
+{
+    std::cout << "compare_small_set";
+
+    {
+        auto std_set = std::set<int>();
+        auto small_set = sel::small_sorted_set<int, 16>();
+
+        for (int i = 0; i < 16; ++i)
+        {
+            int key = (i * 7) % 11;
+            assert(std_set.insert(key).second == small_set.insert(key).second);
+        }
+        assert(small_set.capacity() == 16);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            int key = (i * 7919) % 101;
+            if (i % 4 == 0)
+            {
+                assert(std_set.erase(key) == small_set.erase(key));
+            }
+            else
+            {
+                assert(std_set.insert(key).second == small_set.insert(key).second);
+            }
+        }
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(small_set.cbegin(), small_set.cend()));
+
+        for (int key = -1; key < 103; ++key)
+        {
+            assert(std_set.count(key) == small_set.count(key));
+            assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(small_set.begin(), small_set.lower_bound(key)));
+            assert(std::distance(std_set.begin(), std_set.upper_bound(key)) == std::distance(small_set.begin(), small_set.upper_bound(key)));
+        }
+    }
+
+    {
+        auto std_set = std::set<std::string>({"zero", "one", "two", "three"});
+        auto small_set = sel::small_sorted_set<std::string, 4>({"zero", "one", "two", "three"});
+        auto copy_set = small_set;
+        auto moved_set = std::move(copy_set);
+
+        assert(moved_set == small_set);
+        assert(std::vector<std::string>(std_set.begin(), std_set.end()) == std::vector<std::string>(moved_set.cbegin(), moved_set.cend()));
+
+        moved_set.insert("four");
+        assert(moved_set.capacity() > 4);
+        moved_set.erase("four");
+        moved_set.shrink_to_fit();
+        assert(moved_set.capacity() == 4 && moved_set == small_set);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_small_map()
+{
+    std::cout << "compare_small_map";
+
+    {
+        auto std_map = std::map<uint16_t, uint32_t>();
+        auto small_map = sel::small_sorted_map<uint16_t, uint32_t, 16>();
+
+        for (int i = 0; i < 300; ++i)
+        {
+            uint16_t key = (i * 7919) % 97;
+            if (i % 4 == 0)
+            {
+                assert(std_map.erase(key) == small_map.erase(key));
+            }
+            else
+            {
+                std_map[key] += i;
+                small_map[key] += i;
+            }
+        }
+        auto left = std::vector<std::pair<uint16_t, uint32_t>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<uint16_t, uint32_t>>(small_map.cbegin(), small_map.cend());
+        assert(left == right);
+
+        for (uint16_t key = 0; key < 100; ++key)
+        {
+            assert(std_map.count(key) == small_map.count(key));
+            assert((std_map.find(key) == std_map.end()) == (small_map.find(key) == small_map.end()));
+        }
+    }
+
+    {
+        auto small_map = sel::small_sorted_map<std::string, int, 8>({{"zero", 0}, {"one", 1}, {"two", 2}});
+
+        assert(!small_map.insert(std::make_pair(std::string("one"), 11)).second);
+        assert(small_map.at("one") == 1);
+        assert(!small_map.emplace("two", 22).second);
+        assert(small_map.size() == 3 && small_map.capacity() == 8);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_adaptive_map()
+{
+    std::cout << "compare_adaptive_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto adaptive_map = sel::adaptive_sorted_map<int,int>();
+        auto policy = adaptive_map.policy();
+        policy.segment_size = 8;
+        policy.min_segmented_size = 32;
+        policy.window = 64;
+        adaptive_map.policy(policy);
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            int key = (i * 7919) % 509;
+            if (i % 3 == 0)
+            {
+                assert(std_map.erase(key) == adaptive_map.erase(key));
+            }
+            else
+            {
+                std_map[key] += i;
+                adaptive_map[key] += i;
+            }
+        }
+        assert(adaptive_map.is_segmented());
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(adaptive_map.cbegin(), adaptive_map.cend());
+        assert(left == right);
+        assert(std_map.size() == adaptive_map.size());
+        auto reversed = std::vector<std::pair<int,int>>(adaptive_map.crbegin(), adaptive_map.crend());
+        assert(std::equal(left.crbegin(), left.crend(), reversed.begin()));
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            int key = (i * 31) % 511 - 1;
+            auto std_itr = std_map.find(key);
+            auto adaptive_itr = adaptive_map.find(key);
+            assert((std_itr == std_map.end()) == (adaptive_itr == adaptive_map.end()));
+            assert(std_itr == std_map.end() || std_itr->second == adaptive_itr->second);
+            assert(std::distance(std_map.begin(), std_map.lower_bound(key)) == std::distance(adaptive_map.begin(), adaptive_map.lower_bound(key)));
+            assert(std::distance(std_map.begin(), std_map.upper_bound(key)) == std::distance(adaptive_map.begin(), adaptive_map.upper_bound(key)));
+        }
+        assert(!adaptive_map.is_segmented());
+        adaptive_map.segment_now();
+
+        const auto &const_map = adaptive_map;
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(const_map.count(i) == std_map.count(i));
+            assert(const_map.lower_bound(i) == adaptive_map.lower_bound(i));
+        }
+        assert(adaptive_map.is_segmented());
+
+        auto std_itr = std_map.erase(std_map.lower_bound(100), std_map.lower_bound(300));
+        auto adaptive_itr = adaptive_map.erase(adaptive_map.lower_bound(100), adaptive_map.lower_bound(300));
+        assert(adaptive_itr->first == std_itr->first);
+        assert(std_map.erase(400) == adaptive_map.erase(400));
+        auto even = static_cast<size_t>(std::count_if(std_map.begin(), std_map.end(), [](const std::pair<const int,int> &p) { return p.first % 2 == 0; }));
+        auto erased = sel::erase_if(adaptive_map, [](const std::pair<int,int> &p) { return p.first % 2 == 0; });
+        assert(erased == even);
+        for (auto itr = std_map.begin(); itr != std_map.end();)
+        {
+            itr = itr->first % 2 == 0 ? std_map.erase(itr) : std::next(itr);
+        }
+        adaptive_map.flatten_now();
+        left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        right = std::vector<std::pair<int,int>>(adaptive_map.cbegin(), adaptive_map.cend());
+        assert(left == right);
+    }
+
+    {
+        auto adaptive_map = sel::adaptive_sorted_map<std::string, int>({{"zero", 0}, {"one", 1}, {"two", 2}});
+        auto copy_map = adaptive_map;
+
+        assert(!adaptive_map.insert(std::make_pair(std::string("one"), 11)).second);
+        assert(adaptive_map.at("one") == 1);
+        assert(!adaptive_map.emplace("two", 22).second);
+        assert(adaptive_map.count("three") == 0);
+        assert(copy_map == adaptive_map);
+        adaptive_map.clear();
+        assert(adaptive_map.empty() && adaptive_map.begin() == adaptive_map.end());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_multiset()
+{
+    std::cout << "compare_multiset";
+
+    {
+        auto std_set = std::multiset<int>();
+        auto multi_set = sel::sorted_multiset<int>();
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = (i * 7919) % 61;
+            if (i % 5 == 0)
+            {
+                assert(std_set.erase(key) == multi_set.erase(key));
+            }
+            else
+            {
+                assert(*std_set.insert(key) == *multi_set.insert(key));
+            }
+        }
+        auto bulk = std::vector<int>();
+        for (int i = 0; i < 500; ++i)
+        {
+            bulk.push_back((i * 31) % 73 - 5);
+        }
+        std_set.insert(bulk.begin(), bulk.end());
+        multi_set.insert(bulk.begin(), bulk.end());
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(multi_set.cbegin(), multi_set.cend()));
+
+        for (int key = -6; key < 70; ++key)
+        {
+            assert(std_set.count(key) == multi_set.count(key));
+            auto std_range = std_set.equal_range(key);
+            auto multi_range = multi_set.equal_range(key);
+            assert(std::distance(std_set.begin(), std_range.first) == std::distance(multi_set.begin(), multi_range.first));
+            assert(std::distance(std_set.begin(), std_range.second) == std::distance(multi_set.begin(), multi_range.second));
+            assert((std_set.find(key) == std_set.end()) == (multi_set.find(key) == multi_set.end()));
+        }
+    }
+
+    {
+        auto multi_set = sel::sorted_multiset<std::string>({"b", "a", "b", "c", "a"});
+        auto copy_set = multi_set;
+
+        assert(multi_set.size() == 5 && multi_set.count("a") == 2);
+        multi_set.insert(multi_set.cend(), "d");
+        multi_set.insert(multi_set.cbegin(), "b");
+        assert(multi_set.count("b") == 3 && *multi_set.crbegin() == "d");
+        assert(multi_set.erase("b") == 3);
+        assert(copy_set != multi_set);
+        copy_set.erase(copy_set.find("b"), copy_set.upper_bound("b"));
+        copy_set.emplace("d");
+        assert(copy_set == multi_set);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_multimap()
+{
+    std::cout << "compare_multimap";
+
+    {
+        auto std_map = std::multimap<int,int>();
+        auto multi_map = sel::sorted_multimap<int,int>();
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = (i * 7919) % 61;
+            if (i % 5 == 0)
+            {
+                assert(std_map.erase(key) == multi_map.erase(key));
+            }
+            else
+            {
+                assert(std_map.insert(std::make_pair(key, i))->second == multi_map.insert(std::make_pair(key, i))->second);
+            }
+        }
+        auto bulk = std::vector<std::pair<int,int>>();
+        for (int i = 0; i < 500; ++i)
+        {
+            bulk.push_back(std::make_pair((i * 31) % 73 - 5, i));
+        }
+        std_map.insert(bulk.begin(), bulk.end());
+        multi_map.insert(bulk.begin(), bulk.end());
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(multi_map.cbegin(), multi_map.cend());
+        assert(left == right);
+
+        for (int key = -6; key < 70; ++key)
+        {
+            assert(std_map.count(key) == multi_map.count(key));
+            auto std_range = std_map.equal_range(key);
+            auto multi_range = multi_map.equal_range(key);
+            assert(std::distance(std_map.begin(), std_range.first) == std::distance(multi_map.begin(), multi_range.first));
+            assert(std::distance(std_map.begin(), std_range.second) == std::distance(multi_map.begin(), multi_range.second));
+        }
+    }
+
+    {
+        auto multi_map = sel::sorted_multimap<std::string, int>({{"b", 1}, {"a", 2}, {"b", 3}});
+
+        multi_map.emplace("b", 4);
+        multi_map.insert(multi_map.cbegin(), std::make_pair(std::string("b"), 5));
+        auto range = multi_map.equal_range("b");
+        auto values = std::vector<int>();
+        for (auto itr = range.first; itr != range.second; ++itr)
+        {
+            values.push_back(itr->second);
+        }
+        assert(values == std::vector<int>({1, 3, 4, 5}));
+        assert(multi_map.find("a")->second == 2 && multi_map.find("c") == multi_map.end());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_augmented_map()
+{
+    std::cout << "compare_augmented_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto sum_map = sel::augmented_sorted_map<int,int>();
+        auto min_map = sel::augmented_sorted_map<int, int, sel::min_op<int>>();
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            int key = (i * 7919) % 307;
+            int value = (i * 31) % 97;
+            if (i % 4 == 0)
+            {
+                assert(std_map.erase(key) == sum_map.erase(key));
+                min_map.erase(key);
+            }
+            else
+            {
+                std_map[key] = value;
+                sum_map.insert_or_assign(key, value);
+                min_map.insert_or_assign(key, value);
+            }
+
+            if (i % 50 == 0)
+            {
+                int lo = (i * 13) % 307;
+                int hi = lo + (i % 120);
+                int sum = 0;
+                int min = std::numeric_limits<int>::max();
+                for (auto itr = std_map.lower_bound(lo); itr != std_map.upper_bound(hi); ++itr)
+                {
+                    sum += itr->second;
+                    min = std::min(min, itr->second);
+                }
+                assert(sum_map.aggregate(lo, hi) == sum);
+                assert(min_map.aggregate(lo, hi) == min);
+            }
+        }
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(sum_map.cbegin(), sum_map.cend());
+        assert(left == right);
+
+        int running = 0;
+        for (auto itr = std_map.begin(); itr != std_map.end(); ++itr)
+        {
+            if (itr->second > 0)
+            {
+                assert(sum_map.select(running)->first == itr->first);
+                assert(sum_map.select(running + itr->second - 1)->first == itr->first);
+            }
+            running += itr->second;
+        }
+        assert(sum_map.aggregate() == running);
+        assert(sum_map.select(running) == sum_map.end());
+    }
+
+    {
+        auto max_map = sel::augmented_sorted_map<std::string, double, sel::max_op<double>>({{"a", 1.5}, {"b", 4.0}, {"c", 2.5}});
+
+        assert(max_map.aggregate("a", "c") == 4.0);
+        max_map.update(max_map.find("b"), 0.5);
+        assert(max_map.aggregate("a", "c") == 2.5 && max_map.at("b") == 0.5);
+        assert(max_map.aggregate("a", "b") == 1.5);
+        assert(max_map.aggregate("d", "e") == std::numeric_limits<double>::lowest());
+        max_map.erase(max_map.begin(), max_map.find("c"));
+        assert(max_map.aggregate() == 2.5 && max_map.size() == 1);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_gap_set()
+{
+    std::cout << "compare_gap_set";
+
+    {
+        auto std_set = std::set<int>();
+        auto gap_set = sel::gap_sorted_set<int>();
+
+        int cursor = 500;
+        for (int i = 0; i < 4000; ++i)
+        {
+            cursor += (i * 7919) % 9 - 4;
+            int key = cursor + (i * 31) % 7;
+            if (i % 3 == 0)
+            {
+                assert(std_set.erase(key) == gap_set.erase(key));
+            }
+            else
+            {
+                assert(std_set.insert(key).second == gap_set.insert(key).second);
+            }
+        }
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(gap_set.cbegin(), gap_set.cend()));
+        assert(std::vector<int>(std_set.rbegin(), std_set.rend()) == std::vector<int>(gap_set.crbegin(), gap_set.crend()));
+
+        for (int key = cursor - 600; key < cursor + 600; key += 3)
+        {
+            assert(std_set.count(key) == gap_set.count(key));
+            assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(gap_set.begin(), gap_set.lower_bound(key)));
+            assert(std::distance(std_set.begin(), std_set.upper_bound(key)) == std::distance(gap_set.begin(), gap_set.upper_bound(key)));
+        }
+
+        auto hint = gap_set.cend();
+        for (int key = 10000; key > 9000; --key)
+        {
+            hint = gap_set.insert(hint, key);
+            std_set.insert(key);
+        }
+        gap_set.erase(gap_set.lower_bound(9100), gap_set.lower_bound(9900));
+        std_set.erase(std_set.lower_bound(9100), std_set.lower_bound(9900));
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(gap_set.cbegin(), gap_set.cend()));
+    }
+
+    {
+        auto gap_set = sel::gap_sorted_set<std::string>({"zero", "one", "two", "three"});
+        auto copy_set = gap_set;
+        auto moved_set = std::move(copy_set);
+
+        assert(moved_set == gap_set);
+        moved_set.erase("one");
+        assert(gap_set < moved_set && moved_set != gap_set);
+        moved_set.emplace("one");
+        moved_set.shrink_to_fit();
+        assert(moved_set == gap_set && moved_set.capacity() == moved_set.size());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_gap_map()
+{
+    std::cout << "compare_gap_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto gap_map = sel::gap_sorted_map<int,int>();
+
+        int cursor = 500;
+        for (int i = 0; i < 4000; ++i)
+        {
+            cursor += (i * 7919) % 9 - 4;
+            int key = cursor + (i * 31) % 7;
+            if (i % 3 == 0)
+            {
+                assert(std_map.erase(key) == gap_map.erase(key));
+            }
+            else
+            {
+                std_map[key] += i;
+                gap_map[key] += i;
+            }
+        }
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(gap_map.cbegin(), gap_map.cend());
+        assert(left == right);
+
+        for (int key = cursor - 600; key < cursor + 600; key += 3)
+        {
+            auto std_itr = std_map.find(key);
+            auto gap_itr = gap_map.find(key);
+            assert((std_itr == std_map.end()) == (gap_itr == gap_map.end()));
+            assert(std_itr == std_map.end() || std_itr->second == gap_map.at(key));
+        }
+    }
+
+    {
+        auto gap_map = sel::gap_sorted_map<std::string, int>({{"zero", 0}, {"one", 1}, {"two", 2}});
+
+        assert(!gap_map.insert(std::make_pair(std::string("one"), 11)).second);
+        assert(gap_map.emplace_hint(gap_map.cend(), "zz", 3)->second == 3);
+        assert(gap_map.size() == 4 && gap_map.crbegin()->first == "zz");
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_static_set()
+{
+#if __cplusplus >= 201402L
+    std::cout << "compare_static_set";
+
+    {
+        constexpr auto static_set = sel::make_static_sorted_set<int>({41, 7, 13, 2, 97, 61, 29, 3, 71});
+        static_assert(static_set.size() == 9, "");
+        static_assert(*static_set.begin() == 2 && *(static_set.end() - 1) == 97, "");
+        static_assert(static_set.count(13) == 1 && static_set.count(14) == 0, "");
+        static_assert(*static_set.lower_bound(30) == 41 && static_set.upper_bound(97) == static_set.end(), "");
+
+        auto std_set = std::set<int>(static_set.begin(), static_set.end());
+        for (int key = 0; key < 100; ++key)
+        {
+            assert(std_set.count(key) == static_set.count(key));
+            assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(static_set.begin(), static_set.lower_bound(key)));
+            assert(std::distance(std_set.begin(), std_set.upper_bound(key)) == std::distance(static_set.begin(), static_set.upper_bound(key)));
+        }
+    }
+
+    std::cout << " OK\n";
+#endif
+}
+
+void compare_static_map()
+{
+#if __cplusplus >= 201402L
+    std::cout << "compare_static_map";
+
+    {
+        constexpr auto static_map = sel::make_static_sorted_map<int, int>({{30, 3}, {10, 1}, {50, 5}, {20, 2}, {40, 4}});
+        static_assert(static_map.at(40) == 4 && static_map.find(35) == static_map.end(), "");
+        static_assert(static_map.begin()->first == 10 && static_map.equal_range(20).second->first == 30, "");
+
+        auto std_map = std::map<int,int>({{30, 3}, {10, 1}, {50, 5}, {20, 2}, {40, 4}});
+        for (int key = 0; key < 60; ++key)
+        {
+            auto std_itr = std_map.find(key);
+            auto static_itr = static_map.find(key);
+            assert((std_itr == std_map.end()) == (static_itr == static_map.end()));
+            assert(std_itr == std_map.end() || std_itr->second == static_itr->second);
+            assert(std::distance(std_map.begin(), std_map.upper_bound(key)) == std::distance(static_map.begin(), static_map.upper_bound(key)));
+        }
+
+        bool thrown = false;
+        try
+        {
+            static_map.at(35);
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try
+        {
+            sel::make_static_sorted_map<int, int>({{1, 1}, {2, 2}, {1, 3}});
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << " OK\n";
+#endif
+}
+
+struct constant_hash
+{
+    size_t operator()(int) const
+    {
+        return 42;
+    }
+};
+
+void compare_frozen_map()
+{
+    std::cout << "compare_frozen_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto sel_map = sel::sorted_map<int,int>();
+        for (int i = 0; i < 5000; ++i)
+        {
+            std_map[i * 37 % 20011] = i;
+            sel_map[i * 37 % 20011] = i;
+        }
+        auto frozen_map = sel::frozen_sorted_map<int,int>(std::move(sel_map));
+        assert(frozen_map.hashed() && frozen_map.size() == std_map.size());
+
+        for (int key = -10; key < 20020; ++key)
+        {
+            auto std_itr = std_map.find(key);
+            auto frozen_itr = frozen_map.find(key);
+            assert((std_itr == std_map.end()) == (frozen_itr == frozen_map.end()));
+            assert(std_itr == std_map.end() || std_itr->second == frozen_itr->second);
+            assert(std_map.count(key) == frozen_map.count(key));
+        }
+        assert(std::distance(std_map.begin(), std_map.lower_bound(777)) == std::distance(frozen_map.begin(), frozen_map.lower_bound(777)));
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(frozen_map.cbegin(), frozen_map.cend());
+        assert(left == right);
+
+        frozen_map.at(37) = -1;
+        assert(frozen_map.find(37)->second == -1);
+    }
+
+    {
+        auto frozen_map = sel::frozen_sorted_map<std::string, int>({{"zero", 0}, {"one", 1}, {"two", 2}, {"one", 11}});
+        assert(frozen_map.hashed() && frozen_map.size() == 3);
+        assert(frozen_map.at("one") == 1 && frozen_map.count("three") == 0);
+        assert(frozen_map.cbegin()->first == "one");
+
+        auto fallback_map = sel::frozen_sorted_map<int, int, constant_hash>({{3, 3}, {1, 1}, {2, 2}});
+        assert(!fallback_map.hashed());
+        assert(fallback_map.at(2) == 2 && fallback_map.find(4) == fallback_map.end());
+
+        auto empty_map = sel::frozen_sorted_map<int,int>();
+        assert(empty_map.find(1) == empty_map.end() && empty_map.count(1) == 0);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_radix_set()
+{
+    std::cout << "compare_radix_set";
+
+    {
+        auto std_set = std::set<uint64_t>();
+        auto radix_set = sel::radix_sorted_set<uint64_t>();
+
+        uint64_t x = 88172645463325252ull;
+        for (int i = 0; i < 20000; ++i)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            uint64_t key = i % 4 == 0 ? x % 1000 : x;
+            if (i % 5 == 0)
+            {
+                auto it = std_set.lower_bound(key);
+                uint64_t victim = it == std_set.end() ? key : *it;
+                assert(std_set.erase(victim) == radix_set.erase(victim));
+            }
+            else
+            {
+                assert(std_set.insert(key).second == radix_set.insert(key).second);
+            }
+            if (i % 97 == 0)
+            {
+                assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(radix_set.begin(), radix_set.lower_bound(key)));
+            }
+        }
+        assert(std::vector<uint64_t>(std_set.begin(), std_set.end()) == std::vector<uint64_t>(radix_set.cbegin(), radix_set.cend()));
+        assert(radix_set.directory_size() > 1);
+
+        for (auto key : std_set)
+        {
+            assert(radix_set.count(key) == 1 && *radix_set.find(key) == key);
+            assert(radix_set.count(key + 1) == std_set.count(key + 1));
+            assert(std::distance(std_set.begin(), std_set.upper_bound(key)) == std::distance(radix_set.begin(), radix_set.upper_bound(key)));
+        }
+        assert(radix_set.find(~uint64_t(0)) == radix_set.end());
+    }
+
+    {
+        auto ascending = sel::radix_sorted_set<int64_t>();
+        auto descending = sel::radix_sorted_set<int64_t>();
+        auto lowest = std::numeric_limits<int64_t>::min();
+        for (int64_t i = 0; i < 20000; ++i)
+        {
+            ascending.insert(ascending.cend(), i * 3);
+            descending.insert(descending.cbegin(), lowest + 200000 - i * 4);
+            if (i % 1000 == 0)
+            {
+                assert(ascending.count(i * 3) == 1 && ascending.count(i * 3 - 1) == 0 && ascending.lower_bound(i * 3 - 1) == ascending.cend() - 1);
+                assert(descending.count(lowest + 200000 - i * 4) == 1 && descending.lower_bound(lowest) == descending.cbegin());
+            }
+        }
+        descending.insert(lowest);
+        descending.insert(lowest + 1);
+        assert(ascending.size() == 20000 && descending.size() == 20002);
+        for (int64_t i = 0; i < 19990; i += 7)
+        {
+            assert(*ascending.lower_bound(i * 3 - 2) == i * 3 && *ascending.upper_bound(i * 3) == i * 3 + 3);
+            assert(descending.count(lowest + 200000 - i * 4) == 1 && descending.count(lowest + 200001 - i * 4) == 0);
+        }
+        assert(*descending.cbegin() == lowest && *(descending.cbegin() + 1) == lowest + 1);
+        assert(std::is_sorted(descending.cbegin(), descending.cend()));
+    }
+
+    {
+        auto std_set = std::set<int>();
+        auto radix_set = sel::radix_sorted_set<int>({5, -5, 0});
+        std_set.insert({5, -5, 0});
+
+        auto keys = std::vector<int>();
+        for (int i = 0; i < 3000; ++i)
+        {
+            keys.push_back((i * 7919) % 6001 - 3000);
+        }
+        radix_set.insert(keys.begin(), keys.end());
+        std_set.insert(keys.begin(), keys.end());
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(radix_set.cbegin(), radix_set.cend()));
+
+        auto hint = radix_set.cend();
+        for (int key = 9000; key > 8000; --key)
+        {
+            hint = radix_set.insert(hint, key);
+            std_set.insert(key);
+        }
+        radix_set.erase(radix_set.lower_bound(-2000), radix_set.lower_bound(1000));
+        std_set.erase(std_set.lower_bound(-2000), std_set.lower_bound(1000));
+        for (int key = -3500; key < 9500; key += 7)
+        {
+            assert(std_set.count(key) == radix_set.count(key));
+            assert(std::distance(std_set.begin(), std_set.lower_bound(key)) == std::distance(radix_set.begin(), radix_set.lower_bound(key)));
+        }
+        assert(sel::erase_if(radix_set, [](int key) { return key % 2 == 0; }) > 0);
+        for (auto it = std_set.begin(); it != std_set.end();)
+        {
+            it = *it % 2 == 0 ? std_set.erase(it) : std::next(it);
+        }
+        for (int key = -3500; key < 9500; key += 3)
+        {
+            assert(std_set.count(key) == radix_set.count(key));
+        }
+
+        auto copy_set = radix_set;
+        assert(copy_set == radix_set);
+        copy_set.clear();
+        assert(copy_set.empty() && copy_set.find(1) == copy_set.end() && copy_set.directory_size() == 0);
+        swap(copy_set, radix_set);
+        assert(radix_set.empty() && copy_set.size() == std_set.size());
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_string_map()
+{
+#if __cplusplus >= 201703L
+    std::cout << "compare_string_map";
+
+    {
+        auto std_map = std::map<std::string, int>();
+        auto string_map = sel::string_sorted_map<int>();
+
+        auto keys = std::vector<std::string>();
+        for (int i = 0; i < 3000; ++i)
+        {
+            auto key = std::to_string((i * 7919) % 3001);
+            keys.push_back(i % 3 == 0 ? key : i % 3 == 1 ? "prefix/shared/" + key : std::string(i % 11, 'x') + key);
+        }
+        for (int i = 0; i < 3000; ++i)
+        {
+            auto &key = keys[i];
+            if (i % 4 == 3)
+            {
+                auto &old_key = keys[i / 2];
+                assert(std_map.erase(old_key) == string_map.erase(old_key));
+            }
+            else
+            {
+                assert(std_map.insert(std::make_pair(key, i)).second == string_map.insert(std::make_pair(std::string_view(key), i)).second);
+            }
+        }
+        assert(std_map.size() == string_map.size());
+        auto it = string_map.cbegin();
+        for (auto &pair : std_map)
+        {
+            assert(it->first == pair.first && it->second == pair.second);
+            ++it;
+        }
+        assert(it == string_map.cend());
+
+        for (auto &key : keys)
+        {
+            auto probe = key + "!";
+            assert(std_map.count(key) == string_map.count(key));
+            assert(std::distance(std_map.begin(), std_map.lower_bound(probe)) == std::distance(string_map.begin(), string_map.lower_bound(probe)));
+            assert(std::distance(std_map.begin(), std_map.upper_bound(key)) == std::distance(string_map.begin(), string_map.upper_bound(key)));
+        }
+
+        string_map.erase(string_map.lower_bound("2"), string_map.lower_bound("8"));
+        std_map.erase(std_map.lower_bound("2"), std_map.lower_bound("8"));
+        auto erased_std = std_map.size();
+        for (auto i = std_map.begin(); i != std_map.end();)
+        {
+            i = i->second % 2 == 0 ? std_map.erase(i) : std::next(i);
+        }
+        erased_std -= std_map.size();
+        assert(sel::erase_if(string_map, [](auto pair) { return pair.second % 2 == 0; }) == erased_std);
+        string_map.compact();
+        assert(string_map.dead_bytes() == 0);
+        auto std_items = std::vector<std::pair<std::string, int>>(std_map.begin(), std_map.end());
+        auto string_items = std::vector<std::pair<std::string, int>>();
+        for (auto pair : string_map)
+        {
+            string_items.emplace_back(std::string(pair.first), pair.second);
+        }
+        assert(std_items == string_items);
+    }
+
+    {
+        auto string_map = sel::string_sorted_map<std::string>({{"b", "2"}, {"a", "1"}, {"a very long key", "3"}});
+        assert(string_map.size() == 3 && string_map.begin()->first == "a");
+        string_map["a"] += "1";
+        string_map.insert_or_assign("abcdefghij", "4");
+        string_map.try_emplace(string_map.cend(), "zz", "5");
+        assert(string_map.at("a") == "11" && string_map.at("abcdefghij") == "4" && string_map.rbegin()->second == "5");
+        assert(string_map.contains("a very long key") && !string_map.contains("a very long"));
+        assert(string_map.arena_size() == std::string("a very long keyabcdefghij").size());
+
+        auto zero_key = std::string("ab\0\0\0\0\0\0x", 9);
+        string_map.insert(std::make_pair(std::string_view(zero_key), std::string("6")));
+        string_map.insert(std::make_pair(std::string_view("ab"), std::string("7")));
+        assert(string_map.at(zero_key) == "6" && string_map.at("ab") == "7");
+        assert(std::next(string_map.find("ab"))->first == zero_key);
+        string_map.erase(zero_key);
+        string_map.erase("ab");
+
+        auto copy_map = string_map;
+        assert(copy_map == string_map);
+        copy_map.begin()->second = "changed";
+        assert(copy_map != string_map);
+        swap(copy_map, string_map);
+        assert(string_map.at("a") == "changed");
+
+        bool thrown = false;
+        try
+        {
+            string_map.at("missing");
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    {
+        auto string_map = sel::string_sorted_map<int>();
+        auto std_map = std::map<std::string, int>();
+        for (int i = 0; i < 200; ++i)
+        {
+            auto key = "a long key in the arena " + std::to_string(1000 + i);
+            string_map.emplace(key, i);
+            std_map.emplace(key, i);
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            auto key = string_map.find("a long key in the arena " + std::to_string(1000 + i))->first;
+            auto shorter = key.substr(1);
+            std_map.emplace(std::string(shorter), -i);
+            string_map.try_emplace(shorter, -i);
+        }
+        assert(std_map.size() == string_map.size());
+        auto it = string_map.begin();
+        for (auto &pair : std_map)
+        {
+            assert(it->first == pair.first && it->second == pair.second);
+            ++it;
+        }
+    }
+
+    std::cout << " OK\n";
+#endif
+}
+
+void compare_parallel()
+{
+    std::cout << "compare_parallel";
+
+    {
+        auto std_map = std::map<int, long long>();
+        auto sorted_map = sel::sorted_map<int, long long>();
+        for (int i = 0; i < 100000; ++i)
+        {
+            std_map[i * 3] = (i * 7919) % 100003;
+            sorted_map[i * 3] = (i * 7919) % 100003;
+        }
+
+        auto policy = sel::parallel_policy();
+        policy.threads = 4;
+        policy.min_chunk = 1000;
+
+        sel::parallel_for_each(sorted_map.begin(), sorted_map.end(), [](std::pair<int, long long> &pair) {
+            pair.second *= 2;
+        }, policy);
+        for (auto &pair : std_map)
+        {
+            pair.second *= 2;
+        }
+
+        auto fold = [](long long sum, const std::pair<int, long long> &pair) { return sum + pair.second; };
+        auto add = [](long long lhs, long long rhs) { return lhs + rhs; };
+        auto std_sum = std::accumulate(std_map.begin(), std_map.end(), 0LL, fold);
+        auto parallel_sum = sel::parallel_reduce(sorted_map.cbegin(), sorted_map.cend(), 0LL, fold, add, policy);
+        assert(std_sum == parallel_sum);
+
+        auto std_range_sum = std::accumulate(std_map.lower_bound(500), std_map.upper_bound(90000), 0LL, fold);
+        auto parallel_range_sum = sel::parallel_reduce(sorted_map.lower_bound(500), sorted_map.upper_bound(90000), 0LL, fold, add, policy);
+        assert(std_range_sum == parallel_range_sum);
+
+        auto keys = std::vector<int>(sorted_map.size());
+        auto keys_end = sel::parallel_transform(sorted_map.cbegin(), sorted_map.cend(), keys.begin(), [](const std::pair<int, long long> &pair) {
+            return pair.first;
+        }, policy);
+        assert(keys_end == keys.end());
+        auto std_keys = std::vector<int>();
+        for (auto &pair : std_map)
+        {
+            std_keys.push_back(pair.first);
+        }
+        assert(keys == std_keys);
+    }
+
+    {
+        auto sorted_set = sel::sorted_set<double>();
+        for (int i = 1; i < 50000; ++i)
+        {
+            sorted_set.insert(sorted_set.cend(), 1.0 / (50000 - i) + i * 1e-9);
+        }
+        auto add = [](double lhs, double rhs) { return lhs + rhs; };
+        auto policy = sel::parallel_policy();
+        policy.chunk_size = 777;
+        policy.threads = 1;
+        auto single = sel::parallel_reduce(sorted_set.cbegin(), sorted_set.cend(), 0.0, add, policy);
+        policy.threads = 8;
+        auto many = sel::parallel_reduce(sorted_set.cbegin(), sorted_set.cend(), 0.0, add, policy);
+        assert(single == many);
+
+        auto all_positive = sel::parallel_reduce(sorted_set.cbegin(), sorted_set.cend(), true, [](bool ok, double value) {
+            return ok && value > 0.0;
+        }, [](bool lhs, bool rhs) { return lhs && rhs; }, policy);
+        assert(all_positive);
+
+        bool thrown = false;
+        try
+        {
+            sel::parallel_for_each(sorted_set.cbegin(), sorted_set.cend(), [](double value) {
+                if (value < 1e-4)
+                {
+                    throw std::runtime_error("small");
+                }
+            }, policy);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        auto empty_set = sel::sorted_set<int>();
+        auto empty_sum = sel::parallel_reduce(empty_set.cbegin(), empty_set.cend(), 5, [](int lhs, int rhs) { return lhs + rhs; });
+        assert(empty_sum == 5);
+    }
+
+    std::cout << " OK\n";
+}
+
+std::vector<std::pair<int, int>> std_items(const std::map<int, int> &map)
+{
+    return std::vector<std::pair<int, int>>(map.begin(), map.end());
+}
+
+std::vector<std::pair<int, int>> lsm_items(const sel::lsm_sorted_map<int, int> &map)
+{
+    return std::vector<std::pair<int, int>>(map.begin(), map.end());
+}
+
+void compare_lsm_map()
+{
+    std::cout << "compare_lsm_map";
+
+    for (int background = 0; background < 2; ++background)
+    {
+        auto policy = sel::lsm_policy();
+        policy.memtable_size = 64;
+        policy.fanout = 3;
+        policy.background = background == 1;
+
+        auto std_map = std::map<int, int>();
+        auto lsm_map = sel::lsm_sorted_map<int, int>(policy);
+        for (int i = 0; i < 20000; ++i)
+        {
+            int key = (i * 7919) % 3001;
+            if (i % 3 == 0)
+            {
+                assert(std_map.erase(key) == lsm_map.erase(key));
+            }
+            else if (i % 3 == 1)
+            {
+                assert(std_map.insert(std::make_pair(key, i)).second == lsm_map.insert(std::make_pair(key, i)));
+            }
+            else
+            {
+                auto inserted = std_map.count(key) == 0;
+                std_map[key] = i;
+                assert(lsm_map.insert_or_assign(key, i) == inserted);
+            }
+            assert(std_map.size() == lsm_map.size());
+            if (i % 500 == 0)
+            {
+                assert(lsm_items(lsm_map) == std_items(std_map));
+            }
+        }
+        assert(lsm_map.run_count() > 1);
+
+        for (int key = -5; key < 3010; ++key)
+        {
+            assert(std_map.count(key) == lsm_map.count(key));
+            assert(std_map.count(key) == 0 || lsm_map.at(key) == std_map[key]);
+            auto std_lower = std_map.lower_bound(key);
+            auto lsm_lower = lsm_map.lower_bound(key);
+            assert(std_lower == std_map.end() ? lsm_lower == lsm_map.end() : lsm_lower->first == std_lower->first);
+            auto std_upper = std_map.upper_bound(key);
+            auto lsm_upper = lsm_map.upper_bound(key);
+            assert(std_upper == std_map.end() ? lsm_upper == lsm_map.end() : lsm_upper->first == std_upper->first);
+        }
+
+        auto copy_map = lsm_map;
+        lsm_map[5000] += 7;
+        lsm_map[std_map.begin()->first] += 1;
+        std_map[5000] += 7;
+        std_map[std_map.begin()->first] += 1;
+        assert(copy_map.size() + 1 == lsm_map.size() && copy_map.count(5000) == 0);
+        assert(lsm_items(lsm_map) == std_items(std_map));
+
+        lsm_map.compact();
+        assert(lsm_map.run_count() == 1 && std::distance(lsm_map.begin(), lsm_map.end()) == static_cast<std::ptrdiff_t>(std_map.size()));
+        assert(lsm_items(lsm_map) == std_items(std_map));
+
+        auto moved_map = std::move(lsm_map);
+        assert(moved_map.size() == std_map.size() && lsm_map.empty() && lsm_map.begin() == lsm_map.end());
+        moved_map.clear();
+        assert(moved_map.empty() && moved_map.find(1) == moved_map.end());
+    }
+
+    {
+        auto policy = sel::lsm_policy();
+        policy.memtable_size = 4;
+        policy.fanout = 2;
+        auto lsm_map = sel::lsm_sorted_map<int, int>(policy);
+        for (int key = 1; key <= 9; ++key)
+        {
+            lsm_map.insert(std::make_pair(key, key * 10));
+        }
+        assert(lsm_map.run_count() == 2);
+        auto first = lsm_map.begin();
+        auto &value = lsm_map.at(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(lsm_map.count(3) == 1 && lsm_map.find(7)->second == 70 && lsm_map == lsm_map);
+        assert(lsm_map.run_count() == 2 && first->first == 1 && value == 10);
+        lsm_map.wait();
+        assert(lsm_map.run_count() == 1 && lsm_map.at(1) == 10);
+    }
+
+    {
+        auto lsm_map = sel::lsm_sorted_map<std::string, std::string>({{"b", "2"}, {"a", "1"}});
+        lsm_map.erase("a");
+        lsm_map.insert(std::make_pair(std::string("c"), std::string("3")));
+        assert(lsm_map.size() == 2 && lsm_map.begin()->first == "b" && lsm_map.find("c")->second == "3");
+        bool thrown = false;
+        try
+        {
+            lsm_map.at("a");
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_trace()
+{
+    std::cout << "compare_trace";
+
+    {
+        auto stream = std::stringstream();
+        auto writer = sel::trace_writer(stream);
+        auto std_set = std::set<int>();
+        auto traced_set = sel::traced_container<sel::sorted_set<int>>(writer);
+        auto expected = std::vector<sel::trace_record>();
+        auto expect = [&expected](sel::trace_op op, std::int64_t key, bool hint_end, std::int64_t hint) {
+            auto record = sel::trace_record();
+            record.op = op;
+            record.key = key;
+            record.hint_end = hint_end;
+            record.hint = hint;
+            expected.push_back(record);
+        };
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int key = (i * 7919) % 2003 - 1000;
+            if (i % 4 == 0)
+            {
+                assert(std_set.erase(key) == traced_set.erase(key));
+                expect(sel::trace_op::erase, key, false, 0);
+            }
+            else if (i % 4 == 1 && !traced_set.empty())
+            {
+                auto hint = traced_set.lower_bound(key);
+                expect(sel::trace_op::lower_bound, key, false, 0);
+                expect(sel::trace_op::insert_hint, key, hint == traced_set.end(), hint == traced_set.end() ? 0 : *hint);
+                traced_set.insert(hint, key);
+                std_set.insert(key);
+            }
+            else
+            {
+                assert(std_set.insert(key).second == traced_set.insert(key).second);
+                expect(sel::trace_op::insert, key, false, 0);
+            }
+        }
+        assert(std_set.count(5) == traced_set.count(5) && std_set.upper_bound(5) != std_set.end());
+        expect(sel::trace_op::find, 5, false, 0);
+        assert(*traced_set.upper_bound(5) == *std_set.upper_bound(5));
+        expect(sel::trace_op::upper_bound, 5, false, 0);
+        traced_set.erase(traced_set.find(*std_set.begin()));
+        expect(sel::trace_op::find, *std_set.begin(), false, 0);
+        expect(sel::trace_op::erase, *std_set.begin(), false, 0);
+        std_set.erase(std_set.begin());
+        assert(std::vector<int>(std_set.begin(), std_set.end()) == std::vector<int>(traced_set.container().cbegin(), traced_set.container().cend()));
+        traced_set.clear();
+        expect(sel::trace_op::clear, 0, false, 0);
+        assert(writer.count() == expected.size());
+
+        auto reader = sel::trace_reader(stream);
+        auto record = sel::trace_record();
+        std::size_t index = 0;
+        while (reader.read(record))
+        {
+            auto &e = expected[index++];
+            assert(record.op == e.op && record.key == e.key && record.hint_end == e.hint_end && record.hint == e.hint);
+        }
+        assert(index == expected.size());
+    }
+
+    {
+        auto stream = std::stringstream();
+        auto writer = sel::trace_writer(stream);
+        auto traced_map = sel::traced_container<sel::sorted_map<std::int64_t, int>>(writer);
+        traced_map[-(std::int64_t(1) << 62)] = 1;
+        traced_map.insert(traced_map.end(), std::make_pair(std::int64_t(1) << 62, 2));
+        assert(traced_map.size() == 2 && traced_map.container().at(std::int64_t(1) << 62) == 2);
+
+        auto reader = sel::trace_reader(stream);
+        auto record = sel::trace_record();
+        assert(reader.read(record) && record.op == sel::trace_op::insert && record.key == -(std::int64_t(1) << 62));
+        assert(reader.read(record) && record.op == sel::trace_op::insert_hint && record.hint_end && record.key == std::int64_t(1) << 62);
+        assert(!reader.read(record));
+
+        auto garbage = std::stringstream("not a trace");
+        bool thrown = false;
+        try
+        {
+            sel::trace_reader bad(garbage);
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    std::cout << " OK\n";
+}
+
+void compare_roaring_set()
+{
+    std::cout << "compare_roaring_set";
+
+    auto std_set = std::set<std::uint32_t>();
+    auto roaring_set = sel::roaring_sorted_set();
+
+    // Sparse keys across many chunks, then a dense block that turns one chunk into a bitmap.
+    for (std::uint32_t i = 0; i < 3000; ++i)
+    {
+        auto key = (i * 2654435761u) % 40000000u;
+        assert(std_set.insert(key).second == roaring_set.insert(key).second);
+    }
+    for (std::uint32_t key = 5 << 16; key < (5 << 16) + 10000; key += 2)
+    {
+        std_set.insert(key);
+        roaring_set.insert(roaring_set.end(), key);
+    }
+    assert(std_set.size() == roaring_set.size());
+    assert(std::equal(std_set.begin(), std_set.end(), roaring_set.begin()));
+
+    // Runs, including a range crossing several chunks and the top of the key space.
+    roaring_set.insert_range(1000000, 1300000);
+    roaring_set.insert_range(0xfffffff0u, 0xffffffffu);
+    for (std::uint32_t key = 1000000; key <= 1300000; ++key)
+    {
+        std_set.insert(key);
+    }
+    for (std::uint32_t key = 0xfffffff0u; key != 0; ++key)
+    {
+        std_set.insert(key);
+    }
+    assert(std_set.size() == roaring_set.size());
+    assert(std::equal(std_set.begin(), std_set.end(), roaring_set.begin()));
+    assert(roaring_set.memory_usage() < std_set.size() * sizeof(std::uint32_t) / 4);
+
+    for (std::uint32_t i = 0; i < 20000; ++i)
+    {
+        auto key = i % 3 == 0 ? 1000000 + (i * 7919u) % 300001 : (i * 40503u) % 2000000u;
+        assert(std_set.count(key) == roaring_set.count(key));
+        auto lower = roaring_set.lower_bound(key);
+        auto std_lower = std_set.lower_bound(key);
+        assert((lower == roaring_set.end()) == (std_lower == std_set.end()));
+        assert(lower == roaring_set.end() || *lower == *std_lower);
+        auto upper = roaring_set.upper_bound(key);
+        auto std_upper = std_set.upper_bound(key);
+        assert(upper == roaring_set.end() || *upper == *std_upper);
+        if (i % 2 == 0)
+        {
+            assert(std_set.erase(key) == roaring_set.erase(key));
+        }
+        else
+        {
+            assert(std_set.insert(key).second == roaring_set.insert(key).second);
+        }
+    }
+    assert(roaring_set.upper_bound(0xffffffffu) == roaring_set.end());
+    assert(std_set.size() == roaring_set.size());
+    assert(std::equal(std_set.begin(), std_set.end(), roaring_set.begin()));
+
+    // Erasing most of the dense chunk brings it back to an array.
+    for (std::uint32_t key = 5 << 16; key < (5 << 16) + 9000; key += 2)
+    {
+        assert(std_set.erase(key) == roaring_set.erase(key));
+    }
+    auto it = roaring_set.find(*std_set.begin());
+    it = roaring_set.erase(it);
+    std_set.erase(std_set.begin());
+    assert(*it == *std_set.begin());
+    roaring_set.run_optimize();
+    assert(std::equal(std_set.begin(), std_set.end(), roaring_set.begin()));
+
+    // Set algebra against the std algorithms, with array, bitmap and run chunks on both sides.
+    auto std_other = std::set<std::uint32_t>();
+    auto other = sel::roaring_sorted_set();
+    other.insert_range(1200000, 1500000);
+    for (std::uint32_t key = 1200000; key <= 1500000; ++key)
+    {
+        std_other.insert(key);
+    }
+    for (std::uint32_t i = 0; i < 30000; ++i)
+    {
+        auto key = (i * 97u) % 3000000u;
+        std_other.insert(key);
+        other.insert(key);
+    }
+    auto expected = std::vector<std::uint32_t>();
+    std::set_intersection(std_set.begin(), std_set.end(), std_other.begin(), std_other.end(), std::back_inserter(expected));
+    auto both = roaring_set & other;
+    assert(both.size() == expected.size() && roaring_set.intersection_size(other) == expected.size());
+    assert(std::equal(expected.begin(), expected.end(), both.begin()));
+
+    expected.clear();
+    std::set_union(std_set.begin(), std_set.end(), std_other.begin(), std_other.end(), std::back_inserter(expected));
+    auto either = roaring_set | other;
+    assert(either.size() == expected.size());
+    assert(std::equal(expected.begin(), expected.end(), either.begin()));
+
+    expected.clear();
+    std::set_difference(std_set.begin(), std_set.end(), std_other.begin(), std_other.end(), std::back_inserter(expected));
+    auto only = roaring_set - other;
+    assert(only.size() == expected.size());
+    assert(std::equal(expected.begin(), expected.end(), only.begin()));
+
+    // Reverse iteration over array, bitmap and run chunks.
+    assert(std::equal(std_set.rbegin(), std_set.rend(), roaring_set.rbegin()));
+    assert(std::equal(expected.rbegin(), expected.rend(), only.rbegin()));
+    assert(*std::prev(roaring_set.end()) == *std_set.rbegin() && *std::prev(roaring_set.end(), 2) == *std::next(std_set.rbegin()));
+
+    auto copy = roaring_set;
+    copy -= other;
+    copy |= both;
+    copy &= roaring_set;
+    assert(copy == roaring_set && copy != other);
+
+    auto odd = erase_if(copy, [](std::uint32_t key) { return key % 2 == 1; });
+    assert(odd + copy.size() == roaring_set.size());
+    assert(std::find_if(copy.begin(), copy.end(), [](std::uint32_t key) { return key % 2 == 1; }) == copy.end());
+    copy.clear();
+    assert(copy.empty() && copy.begin() == copy.end());
+
+    // A bitmap stays a bitmap until it is down to half the array limit.
+    auto boundary = sel::roaring_sorted_set();
+    for (std::uint32_t key = 0; key <= 8192; key += 2)
+    {
+        boundary.insert(key);
+    }
+    auto bitmap_bytes = boundary.memory_usage();
+    assert(std::distance(boundary.rbegin(), boundary.rend()) == 4097 && *boundary.rbegin() == 8192 && *std::prev(boundary.end(), 4097) == 0);
+    for (std::uint32_t key = 0; key < 1000; key += 2)
+    {
+        boundary.erase(key);
+        boundary.insert(key);
+    }
+    for (std::uint32_t key = 8192; key > 4096; key -= 2)
+    {
+        boundary.erase(key);
+    }
+    assert(boundary.size() == 2049 && boundary.memory_usage() == bitmap_bytes);
+    boundary.erase(4096);
+    assert(boundary.memory_usage() < bitmap_bytes && *boundary.rbegin() == 4094);
+
+    std::cout << " OK\n";
+}
+
+void compare_window_map()
+{
+    std::cout << "compare_window_map";
+
+    {
+        auto std_map = std::map<int,int>();
+        auto sel_map = sel::window_sorted_map<int,int>();
+        int now = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            switch ((i * 7919) % 11)
+            {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+                now += 1 + i % 3;
+                std_map[now] = i;
+                sel_map.insert(sel_map.end(), std::make_pair(now, i));
+                break;
+            case 4:
+                ++now;
+                std_map[now] = i;
+                sel_map[now] = i;
+                break;
+            case 5:
+                if (!std_map.empty())
+                {
+                    assert(sel_map.front().first == std_map.begin()->first && sel_map.front().second == std_map.begin()->second);
+                    std_map.erase(std_map.begin());
+                    sel_map.pop_front();
+                }
+                break;
+            case 6:
+            {
+                auto key = now - 40 - i % 50;
+                auto expected = std::distance(std_map.begin(), std_map.lower_bound(key));
+                std_map.erase(std_map.begin(), std_map.lower_bound(key));
+                assert(sel_map.trim_before(key) == static_cast<size_t>(expected));
+                break;
+            }
+            case 7:
+            {
+                auto key = now - i % 97;
+                assert(std_map.insert(std::make_pair(key, -i)).second == sel_map.insert(std::make_pair(key, -i)).second);
+                break;
+            }
+            case 8:
+            {
+                auto key = now - i % 89;
+                assert(std_map.erase(key) == sel_map.erase(key));
+                break;
+            }
+            case 9:
+            {
+                auto key = now - i % 83;
+                auto std_pos = std_map.lower_bound(key);
+                auto sel_pos = sel_map.lower_bound(key);
+                assert((std_pos == std_map.end()) == (sel_pos == sel_map.end()));
+                if (std_pos != std_map.end())
+                {
+                    assert(std_pos->first == sel_pos->first && std_pos->second == sel_pos->second);
+                    std_pos = std_map.erase(std_pos);
+                    sel_pos = sel_map.erase(sel_pos);
+                    assert((std_pos == std_map.end()) == (sel_pos == sel_map.end()));
+                    assert(std_pos == std_map.end() || std_pos->first == sel_pos->first);
+                }
+                break;
+            }
+            default:
+            {
+                auto key = now - i % 71;
+                auto std_found = std_map.find(key);
+                auto sel_found = sel_map.find(key);
+                assert((std_found == std_map.end()) == (sel_found == sel_map.end()));
+                assert(std_found == std_map.end() || std_found->second == sel_found->second);
+                break;
+            }
+            }
+            assert(std_map.size() == sel_map.size());
+        }
+        auto left = std::vector<std::pair<int,int>>(std_map.cbegin(), std_map.cend());
+        auto right = std::vector<std::pair<int,int>>(sel_map.cbegin(), sel_map.cend());
+        assert(left == right);
+        assert(sel_map.append_count() > 0 && sel_map.capacity() < 4 * sel_map.size() + 64);
+
+        auto copy = sel_map;
+        assert(copy == sel_map && !(copy < sel_map));
+        copy.pop_front();
+        assert(copy != sel_map && sel_map < copy);
+        sel_map.erase(sel_map.begin(), sel_map.end());
+        assert(sel_map.empty() && sel_map.begin() == sel_map.end());
+    }
+
+    {
+        auto sel_map = sel::window_sorted_map<int,std::string>({{5, "5"}, {1, "1"}, {3, "3"}});
+        sel_map.emplace(7, "7");
+        sel_map.emplace_hint(sel_map.begin(), 0, "0");
+        sel_map.trim_before(3);
+        assert(sel_map.size() == 3 && sel_map.front().second == "3" && sel_map.back().second == "7");
+        assert(sel_map.at(5) == "5" && sel_map.count(1) == 0);
+        sel_map.insert(std::make_pair(4, std::string("4")));
+        sel_map.insert(std::make_pair(2, std::string("2")));
+        auto erased = erase_if(sel_map, [](const std::pair<int,std::string> &p) { return p.first % 2 == 1; });
+        assert(erased == 3 && sel_map.size() == 2 && sel_map.begin()->first == 2);
+    }
+
+    {
+        auto payload = std::make_shared<int>(42);
+        auto sel_map = sel::window_sorted_map<int,std::shared_ptr<int>>();
+        for (int i = 0; i < 10; ++i)
+        {
+            sel_map.emplace(i, payload);
+        }
+        sel_map.pop_front();
+        sel_map.trim_before(3);
+        assert(sel_map.size() == 7 && payload.use_count() == 8);
+        sel_map.clear();
+        sel_map.pop_front();
+        assert(sel_map.empty() && sel_map.size() == 0 && payload.use_count() == 1);
+    }
+
+    std::cout << " OK\n";
+}
+
+struct slab_payload
+{
+    int id = 0;
+    char bytes[500] = {};
+    std::string name;
+
+    slab_payload() {}
+
+    explicit slab_payload(int i) : id(i), name(std::to_string(i) + " payload with a heap allocated name")
+    {
+        bytes[(i < 0 ? -i : i) % 500] = static_cast<char>(i);
+    }
+
+    bool operator==(const slab_payload &other) const
+    {
+        return id == other.id && name == other.name && std::equal(bytes, bytes + 500, other.bytes);
+    }
+};
+
+void compare_slab_map()
+{
+    std::cout << "compare_slab_map";
+
+    {
+        auto std_map = std::map<int,slab_payload>();
+        auto sel_map = sel::slab_sorted_map<int,slab_payload>();
+        for (int i = 0; i < 3000; ++i)
+        {
+            auto key = (i * 7919) % 1009;
+            switch (i % 5)
+            {
+            case 0:
+            case 1:
+                assert(std_map.insert(std::make_pair(key, slab_payload(i))).second == sel_map.insert(std::make_pair(key, slab_payload(i))).second);
+                break;
+            case 2:
+                std_map[key] = slab_payload(-i);
+                sel_map.insert_or_assign(key, slab_payload(-i));
+                break;
+            case 3:
+                assert(std_map.erase(key) == sel_map.erase(key));
+                break;
+            default:
+            {
+                auto std_found = std_map.find(key);
+                auto sel_found = sel_map.find(key);
+                assert((std_found == std_map.end()) == (sel_found == sel_map.end()));
+                assert(std_found == std_map.end() || std_found->second == sel_found->second);
+                break;
+            }
+            }
+        }
+        assert(std_map.size() == sel_map.size());
+        assert(sel_map.slab_capacity() >= sel_map.size() + sel_map.free_slots());
+        auto std_itr = std_map.begin();
+        for (auto sel_itr = sel_map.cbegin(); sel_itr != sel_map.cend(); ++sel_itr, ++std_itr)
+        {
+            assert(sel_itr->first == std_itr->first && sel_itr->second == std_itr->second);
+        }
+
+        auto copy = sel_map;
+        assert(copy == sel_map);
+        copy.begin()->second.id = -1;
+        assert(copy != sel_map);
+        auto moved = std::move(copy);
+        assert(moved.size() == sel_map.size() && copy.empty());
+
+        auto erased = erase_if(sel_map, [](std::pair<const int &, slab_payload &> p) { return p.first % 3 == 0; });
+        for (auto itr = std_map.begin(); itr != std_map.end();)
+        {
+            itr = itr->first % 3 == 0 ? std_map.erase(itr) : std::next(itr);
+        }
+        assert(sel_map.size() == std_map.size() && erased > 0);
+        assert(sel_map.free_slots() >= erased);
+    }
+
+    {
+        auto sel_map = sel::slab_sorted_map<int,slab_payload>();
+        auto &middle = sel_map[501];
+        middle.id = 501;
+        auto address = &middle;
+        for (int i = 0; i < 1000; ++i)
+        {
+            sel_map.try_emplace(i, i);
+        }
+        assert(&sel_map.at(501) == address && sel_map.at(501).id == 501);
+        auto capacity = sel_map.slab_capacity();
+        for (int i = 0; i < 1000; i += 2)
+        {
+            sel_map.erase(i);
+        }
+        assert(sel_map.free_slots() == 500 && &sel_map.at(501) == address);
+        for (int i = 0; i < 1000; i += 2)
+        {
+            sel_map.emplace(i, slab_payload(i));
+        }
+        assert(sel_map.slab_capacity() == capacity && sel_map.free_slots() == 0);
+        assert(sel_map.lower_bound(10)->first == 10 && sel_map.upper_bound(10)->first == 11);
+        assert(sel_map.count(999) == 1 && sel_map.contains(0) && !sel_map.contains(1000));
+        sel_map.clear();
+        assert(sel_map.empty() && sel_map.slab_capacity() == 0);
+    }
+
+    std::cout << " OK\n";
+}
+
 void compare_with_std_set()
 {
     compare_set_constructor();
     compare_set_assigns();
+    compare_set_capacity();
+    compare_set_stats();
     compare_set_insert();
     compare_set_emplace();
     compare_set_erase();
+    compare_set_merge();
+    compare_set_cursor();
+    compare_set_span();
     compare_set_equal_range();
     compare_set_operators();
+    compare_lazy_set();
+    compare_small_set();
+    compare_multiset();
+    compare_gap_set();
+    compare_static_set();
+    compare_radix_set();
+    compare_trace();
+    compare_roaring_set();
 }
 
 void compare_with_std_map()
 {
     compare_map_constructor();
     compare_map_assigns();
+    compare_map_capacity();
+    compare_map_stats();
     compare_map_element_access();
     compare_map_insert();
     compare_map_emplace();
     compare_map_erase();
+    compare_map_merge();
+    compare_map_apply_batch();
+    compare_map_diff();
+    compare_map_cursor();
+    compare_map_span();
     compare_map_equal_range();
     compare_map_operators();
+    compare_lazy_map();
+    compare_small_map();
+    compare_adaptive_map();
+    compare_multimap();
+    compare_augmented_map();
+    compare_gap_map();
+    compare_static_map();
+    compare_frozen_map();
+    compare_string_map();
+    compare_parallel();
+    compare_lsm_map();
+    compare_window_map();
+    compare_slab_map();
 }
\ No newline at end of file
@@ -0,0 +1,587 @@
+/* radix_sorted_set.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::set
+*  for integer keys, with a radix directory that narrows every binary search to a small bucket.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the radix_sorted_set.hpp
+*  to your C++ project and include it.
+*
+*    #include "radix_sorted_set.hpp"
+*
+*  USAGE
+*
+*  This set support the same functionalty as sel.sorted_set for integral keys. Next to the sorted vector the set
+*  keeps a directory indexed by the top bits of key - min, holding the offset where each bucket starts, so a
+*  lookup reads one directory entry and binary searches only inside that bucket. Inserts and erases adjust the
+*  directory in place, a key below or above the span adds buckets at that end, so ascending or descending
+*  inserts do not rebuild it. When the directory has doubled since it was built, or after a bulk change, it is
+*  rebuilt by that insert or erase with about size() / 4 buckets, at most 2^max_directory_bits. Lookups never
+*  change the directory, so const members only read and may be called from several threads at once.
+*
+*    auto myset = sel::radix_sorted_set<uint64_t>({3, 1, 2});
+*    myset.find(2);
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+namespace sel
+{
+    template <class Key, class Allocator = std::allocator<Key>>
+    class radix_sorted_set
+    {
+        static_assert(std::is_integral<Key>::value, "radix_sorted_set needs an integral key");
+
+        template <class K, class A>
+        friend bool operator==(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator!=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator<(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator<=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator>(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator>=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs);
+        template <class K, class A>
+        friend void swap(radix_sorted_set<K, A> &lhs, radix_sorted_set<K, A> &rhs);
+
+        typedef typename std::make_unsigned<Key>::type unsigned_key;
+
+        std::vector<Key, Allocator> m_container;
+        std::vector<std::size_t> m_directory;
+        Key m_min = Key();
+        Key m_max = Key();
+        unsigned m_shift = 0;
+        std::size_t m_built_size = 0;
+        std::size_t m_built_buckets = 0;
+        bool m_dirty = true;
+
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static const unsigned max_directory_bits = 16;
+
+    private:
+        size_type bucket_of(const Key &key) const
+        {
+            return static_cast<size_type>((static_cast<unsigned_key>(key) - static_cast<unsigned_key>(m_min)) >> m_shift);
+        }
+
+        void refresh()
+        {
+            if (!m_dirty && m_container.size() <= 4 * m_built_size + 64)
+            {
+                return;
+            }
+            m_dirty = false;
+            m_built_size = m_container.size();
+            m_directory.clear();
+            if (m_container.empty())
+            {
+                return;
+            }
+            m_min = m_container.front();
+            m_max = m_container.back();
+            auto span = static_cast<unsigned_key>(m_max) - static_cast<unsigned_key>(m_min);
+            unsigned span_bits = 0;
+            while (span_bits < sizeof(unsigned_key) * 8 && (span >> span_bits) != 0)
+            {
+                ++span_bits;
+            }
+            unsigned bits = 1;
+            while (bits < max_directory_bits && (size_type(1) << (bits + 2)) < m_container.size())
+            {
+                ++bits;
+            }
+            m_shift = span_bits > bits ? span_bits - bits : 0;
+            m_directory.assign(bucket_of(m_max) + 2, 0);
+            for (auto &key : m_container)
+            {
+                ++m_directory[bucket_of(key) + 1];
+            }
+            for (size_type i = 1; i < m_directory.size(); ++i)
+            {
+                m_directory[i] += m_directory[i - 1];
+            }
+            m_built_buckets = m_directory.size();
+        }
+
+        bool in_span(const Key &key) const
+        {
+            return !m_dirty && !m_directory.empty() && !(key < m_min) && !(m_max < key);
+        }
+
+        // Grows the span to cover key with the current shift, false when the directory has to be rescaled.
+        bool extend(const Key &key)
+        {
+            auto limit = 2 * m_built_buckets + 64;
+            if (m_max < key)
+            {
+                auto buckets = bucket_of(key) + 2;
+                if (buckets > limit)
+                {
+                    return false;
+                }
+                m_directory.resize(buckets, m_directory.back());
+                m_max = key;
+            }
+            else if (key < m_min)
+            {
+                auto distance = static_cast<unsigned_key>(m_min) - static_cast<unsigned_key>(key);
+                auto room = static_cast<size_type>((static_cast<unsigned_key>(m_min) - static_cast<unsigned_key>(std::numeric_limits<Key>::min())) >> m_shift);
+                auto needed = static_cast<size_type>(((distance - 1) >> m_shift) + 1);
+                auto buckets = std::min(room, std::max(needed, m_directory.size()));
+                if (needed > room || m_directory.size() + needed > limit)
+                {
+                    return false;
+                }
+                buckets = std::min(buckets, limit - m_directory.size());
+                m_directory.insert(m_directory.begin(), buckets, 0);
+                m_min = static_cast<Key>(static_cast<unsigned_key>(m_min) - (static_cast<unsigned_key>(buckets) << m_shift));
+            }
+            return true;
+        }
+
+        void adjust(const Key &key, bool inserted)
+        {
+            if (inserted && !m_dirty && !m_directory.empty() && !extend(key))
+            {
+                m_dirty = true;
+            }
+            if (!in_span(key))
+            {
+                m_dirty = true;
+                return;
+            }
+            for (auto i = bucket_of(key) + 1; i < m_directory.size(); ++i)
+            {
+                inserted ? ++m_directory[i] : --m_directory[i];
+            }
+        }
+
+        template <class It>
+        std::pair<It, It> bucket_range(It first, It last, const Key &key) const
+        {
+            if (m_dirty)
+            {
+                return std::make_pair(first, last);
+            }
+            if (m_directory.empty() || key < m_min)
+            {
+                return std::make_pair(first, first);
+            }
+            if (m_max < key)
+            {
+                return std::make_pair(last, last);
+            }
+            auto bucket = bucket_of(key);
+            return std::make_pair(first + m_directory[bucket], first + m_directory[bucket + 1]);
+        }
+
+        template <class It>
+        It search_lower(It first, It last, const Key &key) const
+        {
+            auto range = bucket_range(first, last, key);
+            return std::lower_bound(range.first, range.second, key);
+        }
+
+        template <class It>
+        It search_upper(It first, It last, const Key &key) const
+        {
+            auto range = bucket_range(first, last, key);
+            return std::upper_bound(range.first, range.second, key);
+        }
+
+        iterator insert_at(const_iterator pos, const Key &value)
+        {
+            adjust(value, true);
+            auto result = m_container.insert(pos, value);
+            refresh();
+            return result;
+        }
+
+    public:
+
+        radix_sorted_set() : m_container() {}
+
+        explicit radix_sorted_set(const Allocator &alloc) : m_container(alloc) {}
+
+        template <class InputIt>
+        radix_sorted_set(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            insert(first, last);
+        }
+
+        radix_sorted_set(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : radix_sorted_set(std::begin(init), std::end(init), alloc)
+        {
+        }
+
+        radix_sorted_set &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        iterator begin() noexcept
+        {
+            return m_container.begin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return m_container.rbegin();
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return m_container.rend();
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+            m_directory.shrink_to_fit();
+        }
+
+        size_type directory_size() const
+        {
+            return m_directory.empty() ? 0 : m_directory.size() - 1;
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+            m_dirty = true;
+            refresh();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            auto first = search_lower(m_container.begin(), m_container.end(), value);
+            if (!(first == m_container.end()) && !(value < *first))
+            {
+                return std::make_pair(first, false);
+            }
+            return std::make_pair(insert_at(first, value), true);
+        }
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            if ((pos == m_container.cbegin() || *(pos - 1) < value) && (pos == m_container.cend() || value < *pos))
+            {
+                return insert_at(pos, value);
+            }
+            return insert(value).first;
+        }
+
+        // Appends the range, sorts it and merges it with the existing keys in one pass, then rebuilds the
+        // directory.
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            auto middle = m_container.size();
+            m_container.insert(m_container.end(), first, last);
+            if (m_container.size() == middle)
+            {
+                return;
+            }
+            std::sort(m_container.begin() + middle, m_container.end());
+            std::inplace_merge(m_container.begin(), m_container.begin() + middle, m_container.end());
+            m_container.erase(std::unique(m_container.begin(), m_container.end()), m_container.end());
+            m_dirty = true;
+            refresh();
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert(value_type(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args &&...args)
+        {
+            return insert(hint, value_type(std::forward<Args>(args)...));
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            adjust(*pos, false);
+            auto result = m_container.erase(pos);
+            refresh();
+            return result;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto result = m_container.erase(first, last);
+            if (first != last)
+            {
+                m_dirty = true;
+                refresh();
+            }
+            return result;
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto find_result = find(key);
+            if (find_result == m_container.end())
+                return 0;
+            erase(find_result);
+            return 1;
+        }
+
+        void swap(radix_sorted_set &other)
+        {
+            m_container.swap(other.m_container);
+            m_directory.swap(other.m_directory);
+            std::swap(m_min, other.m_min);
+            std::swap(m_max, other.m_max);
+            std::swap(m_shift, other.m_shift);
+            std::swap(m_built_size, other.m_built_size);
+            std::swap(m_built_buckets, other.m_built_buckets);
+            std::swap(m_dirty, other.m_dirty);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == m_container.cend() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            auto first = search_lower(m_container.begin(), m_container.end(), key);
+            if (!(first == m_container.end()) && !(key < *first))
+            {
+                return first;
+            }
+            return m_container.end();
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto first = search_lower(m_container.cbegin(), m_container.cend(), key);
+            if (!(first == m_container.cend()) && !(key < *first))
+            {
+                return first;
+            }
+            return m_container.cend();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return search_lower(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return search_lower(m_container.cbegin(), m_container.cend(), key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return search_upper(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return search_upper(m_container.cbegin(), m_container.cend(), key);
+        }
+    };
+
+    template <class Key, class Allocator>
+    const unsigned radix_sorted_set<Key, Allocator>::max_directory_bits;
+
+    template <class K, class A>
+    bool operator==(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container == rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator!=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container != rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator<(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container < rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator<=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container <= rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator>(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container > rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator>=(const radix_sorted_set<K, A> &lhs, const radix_sorted_set<K, A> &rhs)
+    {
+        return lhs.m_container >= rhs.m_container;
+    }
+
+    template <class K, class A>
+    void swap(radix_sorted_set<K, A> &lhs, radix_sorted_set<K, A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class A, class Pred>
+    typename radix_sorted_set<K, A>::size_type erase_if(radix_sorted_set<K, A> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
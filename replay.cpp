@@ -0,0 +1,287 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+#include "sorted_map.hpp"
+#include "lazy_sorted_map.hpp"
+#include "adaptive_sorted_map.hpp"
+#include "gap_sorted_map.hpp"
+#include "lsm_sorted_map.hpp"
+#include "sorted_trace.hpp"
+
+// Replays a trace recorded with sel::traced_container against the map variants and std::map. Every container and
+// operation is printed as one CSV row (or one JSON object with --format json) with the total time and the latency
+// percentiles of the single operations. --synthetic N first records a trace of N mixed operations to the file.
+//
+//   sorted_container_replay [--format csv|json] [--synthetic N] trace-file
+
+struct options
+{
+    std::string path;
+    std::size_t synthetic = 0;
+    bool json = false;
+};
+
+static std::uint64_t g_sink = 0;
+static bool g_first_row = true;
+
+static const char *g_op_names[] = {"insert", "insert_hint", "erase", "find", "lower_bound", "upper_bound", "clear"};
+static const std::size_t g_op_count = sizeof(g_op_names) / sizeof(g_op_names[0]);
+
+void print_header(const options &opts)
+{
+    if (opts.json)
+    {
+        std::cout << "[\n";
+    }
+    else
+    {
+        std::cout << "container,operation,ops,total_ms,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n";
+    }
+}
+
+void print_footer(const options &opts)
+{
+    if (opts.json)
+    {
+        std::cout << "\n]\n";
+    }
+}
+
+void print_result(const options &opts, const char *container, const char *operation, std::vector<std::uint64_t> &latencies)
+{
+    if (latencies.empty())
+    {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double q) {
+        return static_cast<unsigned long long>(latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(q * latencies.size()))]);
+    };
+    unsigned long long total = 0;
+    for (auto latency : latencies)
+    {
+        total += latency;
+    }
+    char numbers[192];
+    if (opts.json)
+    {
+        std::snprintf(numbers, sizeof(numbers), "\"ops\": %zu, \"total_ms\": %.3f, \"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu",
+                      latencies.size(), total / 1e6, percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), static_cast<unsigned long long>(latencies.back()));
+        std::cout << (g_first_row ? "" : ",\n")
+                  << "  {\"container\": \"" << container << "\", \"operation\": \"" << operation << "\", " << numbers << "}";
+    }
+    else
+    {
+        std::snprintf(numbers, sizeof(numbers), "%zu,%.3f,%llu,%llu,%llu,%llu,%llu",
+                      latencies.size(), total / 1e6, percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), static_cast<unsigned long long>(latencies.back()));
+        std::cout << container << ',' << operation << ',' << numbers << '\n';
+    }
+    g_first_row = false;
+    std::cout.flush();
+}
+
+template <class Map>
+typename Map::const_iterator resolve_hint(Map &map, const sel::trace_record &record)
+{
+    return record.hint_end ? map.cend() : typename Map::const_iterator(map.lower_bound(record.hint));
+}
+
+template <class Map>
+void insert_hint(Map &map, typename Map::const_iterator hint, const sel::trace_record &record)
+{
+    g_sink += map.insert(hint, typename Map::value_type(record.key, record.key)) == map.end();
+}
+
+// lsm_sorted_map has no hinted insert, the hint is ignored.
+template <class K, class T, class A>
+typename sel::lsm_sorted_map<K, T, A>::const_iterator resolve_hint(sel::lsm_sorted_map<K, T, A> &map, const sel::trace_record &)
+{
+    return map.cend();
+}
+
+template <class K, class T, class A>
+void insert_hint(sel::lsm_sorted_map<K, T, A> &map, typename sel::lsm_sorted_map<K, T, A>::const_iterator, const sel::trace_record &record)
+{
+    g_sink += map.insert(std::make_pair(record.key, record.key));
+}
+
+template <class Map>
+void replay(const options &opts, const char *name, const std::vector<sel::trace_record> &trace)
+{
+    typedef std::chrono::steady_clock clock;
+    auto map = Map();
+    auto all = std::vector<std::uint64_t>();
+    auto by_op = std::vector<std::vector<std::uint64_t>>(g_op_count);
+    all.reserve(trace.size());
+    for (auto &record : trace)
+    {
+        auto hint = resolve_hint(map, record);
+        auto start = clock::now();
+        switch (record.op)
+        {
+        case sel::trace_op::insert:
+            map.insert(typename Map::value_type(record.key, record.key));
+            break;
+        case sel::trace_op::insert_hint:
+            insert_hint(map, hint, record);
+            break;
+        case sel::trace_op::erase:
+            g_sink += map.erase(record.key);
+            break;
+        case sel::trace_op::find:
+            g_sink += map.find(record.key) == map.end();
+            break;
+        case sel::trace_op::lower_bound:
+            g_sink += map.lower_bound(record.key) == map.end();
+            break;
+        case sel::trace_op::upper_bound:
+            g_sink += map.upper_bound(record.key) == map.end();
+            break;
+        case sel::trace_op::clear:
+            map.clear();
+            break;
+        }
+        auto latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+        all.push_back(latency);
+        by_op[static_cast<std::size_t>(record.op)].push_back(latency);
+    }
+    g_sink += map.size();
+    print_result(opts, name, "all", all);
+    for (std::size_t i = 0; i < g_op_count; ++i)
+    {
+        print_result(opts, name, g_op_names[i], by_op[i]);
+    }
+}
+
+// Bijective mix so that distinct indexes give distinct, uniformly spread keys.
+std::uint64_t permute(std::uint64_t x)
+{
+    x ^= x >> 31;
+    x *= 0x7fb5d329728ea185ULL;
+    x ^= x >> 27;
+    x *= 0x81dadef4bc2dd44dULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Appends in order, inserts and erases at random keys and looks up mostly present keys.
+void record_synthetic(const options &opts)
+{
+    std::ofstream file(opts.path, std::ios::binary);
+    auto writer = sel::trace_writer(file);
+    auto map = sel::traced_container<sel::sorted_map<std::int64_t, std::int64_t>>(writer);
+    std::int64_t next = 0;
+    for (std::size_t i = 0; i < opts.synthetic; ++i)
+    {
+        auto r = permute(i);
+        auto key = static_cast<std::int64_t>(permute(r % (next + 1)) % (4 * opts.synthetic));
+        switch (r % 10)
+        {
+        case 0:
+        case 1:
+            map.insert(map.end(), std::make_pair(4 * opts.synthetic + next++, 0));
+            break;
+        case 2:
+            map.insert(std::make_pair(key, 0));
+            break;
+        case 3:
+            map.erase(key);
+            break;
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+            map.find(key);
+            break;
+        case 8:
+            map.lower_bound(key);
+            break;
+        default:
+            map.upper_bound(key);
+            break;
+        }
+    }
+}
+
+bool parse_options(int argc, char **argv, options &opts)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            opts.path = arg;
+            break;
+        }
+        std::string value = argv[++i];
+        if (arg == "--synthetic")
+        {
+            opts.synthetic = std::strtoull(value.c_str(), nullptr, 10);
+        }
+        else if (arg == "--format" && (value == "csv" || value == "json"))
+        {
+            opts.json = value == "json";
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return !opts.path.empty();
+}
+
+int main(int argc, char **argv)
+{
+    options opts;
+    if (!parse_options(argc, argv, opts))
+    {
+        std::cerr << "usage: " << argv[0] << " [--format csv|json] [--synthetic N] trace-file\n";
+        return 1;
+    }
+
+    if (opts.synthetic > 0)
+    {
+        record_synthetic(opts);
+    }
+
+    auto trace = std::vector<sel::trace_record>();
+    try
+    {
+        std::ifstream file(opts.path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "failed to open " << opts.path << "\n";
+            return 1;
+        }
+        auto reader = sel::trace_reader(file);
+        auto record = sel::trace_record();
+        while (reader.read(record))
+        {
+            trace.push_back(record);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << opts.path << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    print_header(opts);
+    replay<std::map<std::int64_t, std::int64_t>>(opts, "std::map", trace);
+    replay<sel::sorted_map<std::int64_t, std::int64_t>>(opts, "sel::sorted_map", trace);
+    replay<sel::lazy_sorted_map<std::int64_t, std::int64_t>>(opts, "sel::lazy_sorted_map", trace);
+    replay<sel::adaptive_sorted_map<std::int64_t, std::int64_t>>(opts, "sel::adaptive_sorted_map", trace);
+    replay<sel::gap_sorted_map<std::int64_t, std::int64_t>>(opts, "sel::gap_sorted_map", trace);
+    replay<sel::lsm_sorted_map<std::int64_t, std::int64_t>>(opts, "sel::lsm_sorted_map", trace);
+    print_footer(opts);
+
+    return trace.empty() || g_sink != 0 ? 0 : 1;
+}
@@ -0,0 +1,1150 @@
+/* roaring_sorted_set.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that implements std::set<uint32_t> as a compressed
+*  bitmap in the style of Roaring bitmaps.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the roaring_sorted_set.hpp
+*  to your C++ project and include it.
+*
+*    #include "roaring_sorted_set.hpp"
+*
+*  USAGE
+*
+*  The keys are split by their high 16 bits into chunks kept in a sorted vector. Each chunk stores its low 16
+*  bits as a sorted array while it has at most 4096 keys, as a 65536 bit bitmap when it has more, or as a list
+*  of runs after insert_range() or run_optimize() when that is smaller. A bitmap turns back into an array only
+*  when erases bring it down to 2048 keys, so inserts and erases around the limit do not convert every time.
+*  The iterators are bidirectional and ordered, find and lower_bound search one chunk, and the &, |, -
+*  operators and intersection_size() work a chunk at a time with word wide and, or and popcount on the bitmaps.
+*
+*    auto ids = sel::roaring_sorted_set({7, 3});
+*    ids.insert_range(1000000, 2999999);              // two million ids in a few runs
+*    auto both = ids & sel::roaring_sorted_set({3, 1500000});
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <initializer_list>
+
+namespace sel
+{
+    class roaring_sorted_set
+    {
+    public:
+        typedef std::uint32_t key_type;
+        typedef std::uint32_t value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        static const std::uint32_t array_limit = 4096;
+        static const std::uint32_t bitmap_words = 1024;
+
+    private:
+        enum class chunk_kind : unsigned char
+        {
+            array,
+            bitmap,
+            runs
+        };
+
+        struct run
+        {
+            std::uint16_t first;
+            std::uint16_t last;
+        };
+
+        struct chunk
+        {
+            std::uint16_t high = 0;
+            chunk_kind kind = chunk_kind::array;
+            std::uint32_t cardinality = 0;
+            std::vector<std::uint16_t> values;
+            std::vector<std::uint64_t> bits;
+            std::vector<run> runs;
+        };
+
+        // Value and array or run index of a position inside a chunk, value is 65536 past the last key.
+        struct position
+        {
+            std::uint32_t value;
+            std::size_t slot;
+        };
+
+        std::vector<chunk> m_chunks;
+        size_type m_size = 0;
+
+        static int popcount(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(x);
+#else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        static int count_trailing_zeros(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#else
+            int result = 0;
+            while ((x & 1) == 0)
+            {
+                x >>= 1;
+                ++result;
+            }
+            return result;
+#endif
+        }
+
+        static int count_leading_zeros(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(x);
+#else
+            int result = 0;
+            while ((x & (std::uint64_t(1) << 63)) == 0)
+            {
+                x <<= 1;
+                ++result;
+            }
+            return result;
+#endif
+        }
+
+        static bool run_ends_before(const run &r, std::uint32_t low)
+        {
+            return r.last < low;
+        }
+
+        static bool contains(const chunk &c, std::uint32_t low)
+        {
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+                return std::binary_search(c.values.begin(), c.values.end(), static_cast<std::uint16_t>(low));
+            case chunk_kind::bitmap:
+                return (c.bits[low >> 6] >> (low & 63)) & 1;
+            default:
+            {
+                auto r = std::lower_bound(c.runs.begin(), c.runs.end(), low, run_ends_before);
+                return r != c.runs.end() && r->first <= low;
+            }
+            }
+        }
+
+        static position seek(const chunk &c, std::uint32_t low)
+        {
+            if (low > 0xffff)
+            {
+                return position{0x10000, 0};
+            }
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+            {
+                auto i = std::lower_bound(c.values.begin(), c.values.end(), static_cast<std::uint16_t>(low)) - c.values.begin();
+                return position{i == static_cast<std::ptrdiff_t>(c.values.size()) ? 0x10000u : c.values[i], static_cast<std::size_t>(i)};
+            }
+            case chunk_kind::bitmap:
+            {
+                auto w = low >> 6;
+                auto word = c.bits[w] & (~std::uint64_t(0) << (low & 63));
+                while (word == 0)
+                {
+                    if (++w == bitmap_words)
+                    {
+                        return position{0x10000, 0};
+                    }
+                    word = c.bits[w];
+                }
+                return position{w * 64 + count_trailing_zeros(word), 0};
+            }
+            default:
+            {
+                auto i = std::lower_bound(c.runs.begin(), c.runs.end(), low, run_ends_before) - c.runs.begin();
+                if (i == static_cast<std::ptrdiff_t>(c.runs.size()))
+                {
+                    return position{0x10000, static_cast<std::size_t>(i)};
+                }
+                return position{std::max<std::uint32_t>(c.runs[i].first, low), static_cast<std::size_t>(i)};
+            }
+            }
+        }
+
+        static position advance(const chunk &c, position p)
+        {
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+                ++p.slot;
+                p.value = p.slot == c.values.size() ? 0x10000u : c.values[p.slot];
+                return p;
+            case chunk_kind::bitmap:
+                return seek(c, p.value + 1);
+            default:
+                if (p.value < c.runs[p.slot].last)
+                {
+                    ++p.value;
+                    return p;
+                }
+                ++p.slot;
+                p.value = p.slot == c.runs.size() ? 0x10000u : c.runs[p.slot].first;
+                return p;
+            }
+        }
+
+        // Moves p to the key before it in the chunk, false when p is at the first key. A value past the last key
+        // moves to the last key.
+        static bool retreat(const chunk &c, position &p)
+        {
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+            {
+                auto i = std::lower_bound(c.values.begin(), c.values.end(), p.value) - c.values.begin();
+                if (i == 0)
+                {
+                    return false;
+                }
+                p = position{c.values[i - 1], static_cast<std::size_t>(i - 1)};
+                return true;
+            }
+            case chunk_kind::bitmap:
+            {
+                auto w = p.value >> 6;
+                auto word = w < bitmap_words ? c.bits[w] & ((std::uint64_t(1) << (p.value & 63)) - 1) : 0;
+                while (word == 0)
+                {
+                    if (w == 0)
+                    {
+                        return false;
+                    }
+                    word = c.bits[--w];
+                }
+                p = position{w * 64 + 63 - count_leading_zeros(word), 0};
+                return true;
+            }
+            default:
+            {
+                auto i = std::lower_bound(c.runs.begin(), c.runs.end(), p.value, run_ends_before) - c.runs.begin();
+                if (i < static_cast<std::ptrdiff_t>(c.runs.size()) && c.runs[i].first < p.value)
+                {
+                    p = position{p.value - 1, static_cast<std::size_t>(i)};
+                    return true;
+                }
+                if (i == 0)
+                {
+                    return false;
+                }
+                p = position{c.runs[i - 1].last, static_cast<std::size_t>(i - 1)};
+                return true;
+            }
+            }
+        }
+
+        static std::vector<std::uint64_t> to_bits(const chunk &c)
+        {
+            if (c.kind == chunk_kind::bitmap)
+            {
+                return c.bits;
+            }
+            auto bits = std::vector<std::uint64_t>(bitmap_words, 0);
+            if (c.kind == chunk_kind::array)
+            {
+                for (auto low : c.values)
+                {
+                    bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+                }
+                return bits;
+            }
+            for (auto &r : c.runs)
+            {
+                set_range(bits, r.first, r.last);
+            }
+            return bits;
+        }
+
+        static void set_range(std::vector<std::uint64_t> &bits, std::uint32_t first, std::uint32_t last)
+        {
+            for (auto w = first >> 6; w <= last >> 6; ++w)
+            {
+                auto lo = w == first >> 6 ? first & 63 : 0;
+                auto hi = w == last >> 6 ? last & 63 : 63;
+                bits[w] |= (hi == 63 ? ~std::uint64_t(0) : (std::uint64_t(1) << (hi + 1)) - 1) & (~std::uint64_t(0) << lo);
+            }
+        }
+
+        static void make_bitmap(chunk &c)
+        {
+            c.bits = to_bits(c);
+            c.kind = chunk_kind::bitmap;
+            c.values = std::vector<std::uint16_t>();
+            c.runs = std::vector<run>();
+        }
+
+        static void make_array(chunk &c)
+        {
+            auto values = std::vector<std::uint16_t>();
+            values.reserve(c.cardinality);
+            for (auto p = seek(c, 0); p.value <= 0xffff; p = advance(c, p))
+            {
+                values.push_back(static_cast<std::uint16_t>(p.value));
+            }
+            c.values.swap(values);
+            c.kind = chunk_kind::array;
+            c.bits = std::vector<std::uint64_t>();
+            c.runs = std::vector<run>();
+        }
+
+        static void make_runs(chunk &c)
+        {
+            auto runs = std::vector<run>();
+            for (auto p = seek(c, 0); p.value <= 0xffff; p = advance(c, p))
+            {
+                if (!runs.empty() && runs.back().last + 1u == p.value)
+                {
+                    runs.back().last = static_cast<std::uint16_t>(p.value);
+                }
+                else
+                {
+                    runs.push_back(run{static_cast<std::uint16_t>(p.value), static_cast<std::uint16_t>(p.value)});
+                }
+            }
+            c.runs.swap(runs);
+            c.kind = chunk_kind::runs;
+            c.values = std::vector<std::uint16_t>();
+            c.bits = std::vector<std::uint64_t>();
+        }
+
+        static std::size_t count_runs(const chunk &c)
+        {
+            if (c.kind == chunk_kind::runs)
+            {
+                return c.runs.size();
+            }
+            std::size_t result = 0;
+            std::uint32_t previous = 0x10000;
+            for (auto p = seek(c, 0); p.value <= 0xffff; p = advance(c, p))
+            {
+                result += previous + 1 != p.value ? 1 : 0;
+                previous = p.value;
+            }
+            return result;
+        }
+
+        // Switches the chunk to the smallest of the array, bitmap and, when allowed, run representation.
+        static void optimize(chunk &c, bool allow_runs)
+        {
+            auto array_bytes = c.cardinality <= array_limit ? 2 * c.cardinality : 0xffffffffu;
+            auto bitmap_bytes = 8 * bitmap_words;
+            auto run_bytes = allow_runs ? 4 * count_runs(c) : 0xffffffffu;
+            if (run_bytes < array_bytes && run_bytes < bitmap_bytes)
+            {
+                if (c.kind != chunk_kind::runs)
+                {
+                    make_runs(c);
+                }
+            }
+            else if (array_bytes <= bitmap_bytes)
+            {
+                if (c.kind != chunk_kind::array)
+                {
+                    make_array(c);
+                }
+            }
+            else if (c.kind != chunk_kind::bitmap)
+            {
+                make_bitmap(c);
+            }
+        }
+
+        static chunk from_bits(std::uint16_t high, std::vector<std::uint64_t> &&bits)
+        {
+            auto c = chunk();
+            c.high = high;
+            c.kind = chunk_kind::bitmap;
+            for (auto word : bits)
+            {
+                c.cardinality += popcount(word);
+            }
+            c.bits.swap(bits);
+            if (c.cardinality <= array_limit)
+            {
+                make_array(c);
+            }
+            return c;
+        }
+
+        static chunk from_values(std::uint16_t high, std::vector<std::uint16_t> &&values)
+        {
+            auto c = chunk();
+            c.high = high;
+            c.cardinality = static_cast<std::uint32_t>(values.size());
+            c.values.swap(values);
+            if (c.cardinality > array_limit)
+            {
+                make_bitmap(c);
+            }
+            return c;
+        }
+
+        static bool insert_low(chunk &c, std::uint32_t low)
+        {
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+            {
+                auto i = std::lower_bound(c.values.begin(), c.values.end(), static_cast<std::uint16_t>(low));
+                if (i != c.values.end() && *i == low)
+                {
+                    return false;
+                }
+                c.values.insert(i, static_cast<std::uint16_t>(low));
+                if (++c.cardinality > array_limit)
+                {
+                    make_bitmap(c);
+                }
+                return true;
+            }
+            case chunk_kind::bitmap:
+            {
+                auto mask = std::uint64_t(1) << (low & 63);
+                if (c.bits[low >> 6] & mask)
+                {
+                    return false;
+                }
+                c.bits[low >> 6] |= mask;
+                ++c.cardinality;
+                return true;
+            }
+            default:
+            {
+                auto i = std::lower_bound(c.runs.begin(), c.runs.end(), low, [](const run &r, std::uint32_t v) {
+                    return r.last + 1u < v;
+                }) - c.runs.begin();
+                auto n = static_cast<std::ptrdiff_t>(c.runs.size());
+                if (i < n && c.runs[i].first <= low && low <= c.runs[i].last)
+                {
+                    return false;
+                }
+                if (i < n && c.runs[i].last + 1u == low)
+                {
+                    c.runs[i].last = static_cast<std::uint16_t>(low);
+                    if (i + 1 < n && c.runs[i + 1].first == low + 1)
+                    {
+                        c.runs[i].last = c.runs[i + 1].last;
+                        c.runs.erase(c.runs.begin() + i + 1);
+                    }
+                }
+                else if (i < n && c.runs[i].first == low + 1)
+                {
+                    c.runs[i].first = static_cast<std::uint16_t>(low);
+                }
+                else
+                {
+                    c.runs.insert(c.runs.begin() + i, run{static_cast<std::uint16_t>(low), static_cast<std::uint16_t>(low)});
+                }
+                ++c.cardinality;
+                if (4 * c.runs.size() > 8 * bitmap_words)
+                {
+                    make_bitmap(c);
+                }
+                return true;
+            }
+            }
+        }
+
+        static bool erase_low(chunk &c, std::uint32_t low)
+        {
+            switch (c.kind)
+            {
+            case chunk_kind::array:
+            {
+                auto i = std::lower_bound(c.values.begin(), c.values.end(), static_cast<std::uint16_t>(low));
+                if (i == c.values.end() || *i != low)
+                {
+                    return false;
+                }
+                c.values.erase(i);
+                --c.cardinality;
+                return true;
+            }
+            case chunk_kind::bitmap:
+            {
+                auto mask = std::uint64_t(1) << (low & 63);
+                if (!(c.bits[low >> 6] & mask))
+                {
+                    return false;
+                }
+                c.bits[low >> 6] &= ~mask;
+                if (--c.cardinality <= array_limit / 2)
+                {
+                    make_array(c);
+                }
+                return true;
+            }
+            default:
+            {
+                auto i = std::lower_bound(c.runs.begin(), c.runs.end(), low, run_ends_before);
+                if (i == c.runs.end() || low < i->first)
+                {
+                    return false;
+                }
+                if (i->first == i->last)
+                {
+                    c.runs.erase(i);
+                }
+                else if (i->first == low)
+                {
+                    ++i->first;
+                }
+                else if (i->last == low)
+                {
+                    --i->last;
+                }
+                else
+                {
+                    auto upper = run{static_cast<std::uint16_t>(low + 1), i->last};
+                    i->last = static_cast<std::uint16_t>(low - 1);
+                    c.runs.insert(i + 1, upper);
+                }
+                --c.cardinality;
+                if (4 * c.runs.size() > 8 * bitmap_words || 4 * c.runs.size() > 2 * c.cardinality)
+                {
+                    optimize(c, false);
+                }
+                return true;
+            }
+            }
+        }
+
+        static bool chunk_before(const chunk &c, std::uint32_t high)
+        {
+            return c.high < high;
+        }
+
+        std::size_t find_chunk(std::uint32_t high) const
+        {
+            return std::lower_bound(m_chunks.begin(), m_chunks.end(), high, chunk_before) - m_chunks.begin();
+        }
+
+        chunk &chunk_for(std::uint32_t high)
+        {
+            auto i = find_chunk(high);
+            if (i == m_chunks.size() || m_chunks[i].high != high)
+            {
+                auto c = chunk();
+                c.high = static_cast<std::uint16_t>(high);
+                m_chunks.insert(m_chunks.begin() + i, std::move(c));
+            }
+            return m_chunks[i];
+        }
+
+        static std::uint32_t key_of(const chunk &c, std::uint32_t low)
+        {
+            return (static_cast<std::uint32_t>(c.high) << 16) | low;
+        }
+
+        template <class Combine>
+        static roaring_sorted_set combine(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs, bool keep_lhs, bool keep_rhs, Combine both)
+        {
+            auto result = roaring_sorted_set();
+            auto l = lhs.m_chunks.begin();
+            auto r = rhs.m_chunks.begin();
+            while (l != lhs.m_chunks.end() || r != rhs.m_chunks.end())
+            {
+                if (r == rhs.m_chunks.end() || (l != lhs.m_chunks.end() && l->high < r->high))
+                {
+                    if (keep_lhs)
+                    {
+                        result.m_chunks.push_back(*l);
+                    }
+                    ++l;
+                }
+                else if (l == lhs.m_chunks.end() || r->high < l->high)
+                {
+                    if (keep_rhs)
+                    {
+                        result.m_chunks.push_back(*r);
+                    }
+                    ++r;
+                }
+                else
+                {
+                    auto c = both(*l, *r);
+                    if (c.cardinality != 0)
+                    {
+                        result.m_chunks.push_back(std::move(c));
+                    }
+                    ++l;
+                    ++r;
+                }
+            }
+            for (auto &c : result.m_chunks)
+            {
+                result.m_size += c.cardinality;
+            }
+            return result;
+        }
+
+        static chunk filter(const chunk &array, const chunk &other, bool keep_contained)
+        {
+            auto values = std::vector<std::uint16_t>();
+            for (auto low : array.values)
+            {
+                if (contains(other, low) == keep_contained)
+                {
+                    values.push_back(low);
+                }
+            }
+            return from_values(array.high, std::move(values));
+        }
+
+        static chunk intersect_chunks(const chunk &a, const chunk &b)
+        {
+            if (a.kind == chunk_kind::array)
+            {
+                return filter(a, b, true);
+            }
+            if (b.kind == chunk_kind::array)
+            {
+                return filter(b, a, true);
+            }
+            auto bits = to_bits(a);
+            auto other = to_bits(b);
+            for (std::uint32_t w = 0; w < bitmap_words; ++w)
+            {
+                bits[w] &= other[w];
+            }
+            return from_bits(a.high, std::move(bits));
+        }
+
+        static chunk unite_chunks(const chunk &a, const chunk &b)
+        {
+            if (a.kind == chunk_kind::array && b.kind == chunk_kind::array)
+            {
+                auto values = std::vector<std::uint16_t>();
+                values.reserve(a.values.size() + b.values.size());
+                std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(values));
+                return from_values(a.high, std::move(values));
+            }
+            auto bits = to_bits(a);
+            auto other = to_bits(b);
+            for (std::uint32_t w = 0; w < bitmap_words; ++w)
+            {
+                bits[w] |= other[w];
+            }
+            return from_bits(a.high, std::move(bits));
+        }
+
+        static chunk subtract_chunks(const chunk &a, const chunk &b)
+        {
+            if (a.kind == chunk_kind::array)
+            {
+                return filter(a, b, false);
+            }
+            auto bits = to_bits(a);
+            auto other = to_bits(b);
+            for (std::uint32_t w = 0; w < bitmap_words; ++w)
+            {
+                bits[w] &= ~other[w];
+            }
+            return from_bits(a.high, std::move(bits));
+        }
+
+    public:
+        class const_iterator
+        {
+            friend class roaring_sorted_set;
+            const roaring_sorted_set *m_owner = nullptr;
+            std::size_t m_chunk = 0;
+            position m_position = position{0, 0};
+
+            const_iterator(const roaring_sorted_set *owner, std::size_t chunk, position p) : m_owner(owner), m_chunk(chunk), m_position(p)
+            {
+                skip_empty();
+            }
+
+            void skip_empty()
+            {
+                while (m_chunk < m_owner->m_chunks.size() && m_position.value > 0xffff)
+                {
+                    if (++m_chunk < m_owner->m_chunks.size())
+                    {
+                        m_position = seek(m_owner->m_chunks[m_chunk], 0);
+                    }
+                }
+                if (m_chunk == m_owner->m_chunks.size())
+                {
+                    m_position = position{0, 0};
+                }
+            }
+
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef std::uint32_t value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const std::uint32_t *pointer;
+            typedef std::uint32_t reference;
+
+            const_iterator() {}
+
+            reference operator*() const
+            {
+                return key_of(m_owner->m_chunks[m_chunk], m_position.value);
+            }
+
+            const_iterator &operator++()
+            {
+                m_position = advance(m_owner->m_chunks[m_chunk], m_position);
+                skip_empty();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto result = *this;
+                ++(*this);
+                return result;
+            }
+
+            const_iterator &operator--()
+            {
+                auto &chunks = m_owner->m_chunks;
+                if (m_chunk < chunks.size() && retreat(chunks[m_chunk], m_position))
+                {
+                    return *this;
+                }
+                while (m_chunk > 0)
+                {
+                    m_position = position{0x10000, 0};
+                    if (retreat(chunks[--m_chunk], m_position))
+                    {
+                        break;
+                    }
+                }
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                auto result = *this;
+                --(*this);
+                return result;
+            }
+
+            bool operator==(const const_iterator &other) const
+            {
+                return m_chunk == other.m_chunk && m_position.value == other.m_position.value;
+            }
+
+            bool operator!=(const const_iterator &other) const
+            {
+                return !(*this == other);
+            }
+        };
+
+        typedef const_iterator iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+
+        roaring_sorted_set() {}
+
+        template <class InputIt>
+        roaring_sorted_set(InputIt first, InputIt last)
+        {
+            insert(first, last);
+        }
+
+        roaring_sorted_set(std::initializer_list<value_type> init)
+            : roaring_sorted_set(std::begin(init), std::end(init))
+        {
+        }
+
+        roaring_sorted_set &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        const_iterator begin() const
+        {
+            return m_chunks.empty() ? end() : const_iterator(this, 0, seek(m_chunks.front(), 0));
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, m_chunks.size(), position{0, 0});
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const
+        {
+            return rbegin();
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const
+        {
+            return rend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type chunk_count() const noexcept
+        {
+            return m_chunks.size();
+        }
+
+        // Bytes used by the chunk payloads.
+        size_type memory_usage() const noexcept
+        {
+            size_type result = m_chunks.capacity() * sizeof(chunk);
+            for (auto &c : m_chunks)
+            {
+                result += c.values.capacity() * sizeof(std::uint16_t) + c.bits.capacity() * sizeof(std::uint64_t) + c.runs.capacity() * sizeof(run);
+            }
+            return result;
+        }
+
+        void clear() noexcept
+        {
+            m_chunks.clear();
+            m_size = 0;
+        }
+
+        std::pair<const_iterator, bool> insert(value_type value)
+        {
+            auto high = value >> 16;
+            auto inserted = insert_low(chunk_for(high), value & 0xffff);
+            m_size += inserted ? 1 : 0;
+            return std::make_pair(find(value), inserted);
+        }
+
+        const_iterator insert(const_iterator, value_type value)
+        {
+            return insert(value).first;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                auto value = static_cast<value_type>(*first);
+                m_size += insert_low(chunk_for(value >> 16), value & 0xffff) ? 1 : 0;
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        // Inserts every key in the closed range [first, last].
+        void insert_range(value_type first, value_type last)
+        {
+            if (last < first)
+            {
+                return;
+            }
+            for (std::uint32_t high = first >> 16; high <= last >> 16; ++high)
+            {
+                auto &c = chunk_for(high);
+                auto lo = high == first >> 16 ? first & 0xffff : 0;
+                auto hi = high == last >> 16 ? last & 0xffff : 0xffff;
+                m_size -= c.cardinality;
+                if (lo == 0 && hi == 0xffff)
+                {
+                    c.runs.assign(1, run{0, 0xffff});
+                    c.kind = chunk_kind::runs;
+                    c.cardinality = 0x10000;
+                    c.values = std::vector<std::uint16_t>();
+                    c.bits = std::vector<std::uint64_t>();
+                }
+                else
+                {
+                    auto bits = to_bits(c);
+                    set_range(bits, lo, hi);
+                    c = from_bits(c.high, std::move(bits));
+                    optimize(c, true);
+                }
+                m_size += c.cardinality;
+                if (high == 0xffff)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Converts every chunk to the smallest representation, including runs.
+        void run_optimize()
+        {
+            for (auto &c : m_chunks)
+            {
+                optimize(c, true);
+            }
+        }
+
+        const_iterator erase(const_iterator pos)
+        {
+            auto value = *pos;
+            erase(value);
+            return lower_bound(value);
+        }
+
+        size_type erase(value_type value)
+        {
+            auto i = find_chunk(value >> 16);
+            if (i == m_chunks.size() || m_chunks[i].high != value >> 16 || !erase_low(m_chunks[i], value & 0xffff))
+            {
+                return 0;
+            }
+            if (m_chunks[i].cardinality == 0)
+            {
+                m_chunks.erase(m_chunks.begin() + i);
+            }
+            --m_size;
+            return 1;
+        }
+
+        void swap(roaring_sorted_set &other) noexcept
+        {
+            m_chunks.swap(other.m_chunks);
+            std::swap(m_size, other.m_size);
+        }
+
+        size_type count(value_type value) const
+        {
+            return contains(value) ? 1 : 0;
+        }
+
+        bool contains(value_type value) const
+        {
+            auto i = find_chunk(value >> 16);
+            return i != m_chunks.size() && m_chunks[i].high == value >> 16 && contains(m_chunks[i], value & 0xffff);
+        }
+
+        const_iterator find(value_type value) const
+        {
+            auto result = lower_bound(value);
+            return result != end() && *result == value ? result : end();
+        }
+
+        const_iterator lower_bound(value_type value) const
+        {
+            auto i = find_chunk(value >> 16);
+            if (i == m_chunks.size())
+            {
+                return end();
+            }
+            auto low = m_chunks[i].high == value >> 16 ? value & 0xffff : 0;
+            return const_iterator(this, i, seek(m_chunks[i], low));
+        }
+
+        const_iterator upper_bound(value_type value) const
+        {
+            return value == 0xffffffffu ? end() : lower_bound(value + 1);
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(value_type value) const
+        {
+            return std::make_pair(lower_bound(value), upper_bound(value));
+        }
+
+        size_type intersection_size(const roaring_sorted_set &other) const
+        {
+            size_type result = 0;
+            auto l = m_chunks.begin();
+            auto r = other.m_chunks.begin();
+            while (l != m_chunks.end() && r != other.m_chunks.end())
+            {
+                if (l->high < r->high)
+                {
+                    ++l;
+                }
+                else if (r->high < l->high)
+                {
+                    ++r;
+                }
+                else
+                {
+                    if (l->kind == chunk_kind::array || r->kind == chunk_kind::array)
+                    {
+                        auto &array = l->kind == chunk_kind::array ? *l : *r;
+                        auto &rest = l->kind == chunk_kind::array ? *r : *l;
+                        for (auto low : array.values)
+                        {
+                            result += contains(rest, low) ? 1 : 0;
+                        }
+                    }
+                    else
+                    {
+                        auto bits = to_bits(*l);
+                        auto rest = to_bits(*r);
+                        for (std::uint32_t w = 0; w < bitmap_words; ++w)
+                        {
+                            result += popcount(bits[w] & rest[w]);
+                        }
+                    }
+                    ++l;
+                    ++r;
+                }
+            }
+            return result;
+        }
+
+        friend roaring_sorted_set operator&(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs)
+        {
+            return combine(lhs, rhs, false, false, intersect_chunks);
+        }
+
+        friend roaring_sorted_set operator|(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs)
+        {
+            return combine(lhs, rhs, true, true, unite_chunks);
+        }
+
+        friend roaring_sorted_set operator-(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs)
+        {
+            return combine(lhs, rhs, true, false, subtract_chunks);
+        }
+
+        roaring_sorted_set &operator&=(const roaring_sorted_set &other)
+        {
+            auto result = *this & other;
+            swap(result);
+            return *this;
+        }
+
+        roaring_sorted_set &operator|=(const roaring_sorted_set &other)
+        {
+            auto result = *this | other;
+            swap(result);
+            return *this;
+        }
+
+        roaring_sorted_set &operator-=(const roaring_sorted_set &other)
+        {
+            auto result = *this - other;
+            swap(result);
+            return *this;
+        }
+
+        friend bool operator==(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs)
+        {
+            return lhs.m_size == rhs.m_size && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const roaring_sorted_set &lhs, const roaring_sorted_set &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend void swap(roaring_sorted_set &lhs, roaring_sorted_set &rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    };
+
+    template <class Pred>
+    roaring_sorted_set::size_type erase_if(roaring_sorted_set &c, Pred pred)
+    {
+        auto erased = std::vector<std::uint32_t>();
+        for (auto value : c)
+        {
+            if (pred(value))
+            {
+                erased.push_back(value);
+            }
+        }
+        for (auto value : erased)
+        {
+            c.erase(value);
+        }
+        return erased.size();
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,741 @@
+/* slab_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::map
+*  for large mapped types, the values are kept out of line in a slab of fixed size blocks.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the slab_sorted_map.hpp
+*  to your C++ project and include it.
+*
+*    #include "slab_sorted_map.hpp"
+*
+*  USAGE
+*
+*  The map support the same functionalty as sel.sorted_map but the sorted vector only holds every key and a
+*  32 bit index into the slab, so inserts and erases shift a few bytes per element whatever the size of T and
+*  growing the vector never copies a value. The slab allocates blocks of block_size values that are never moved,
+*  references and pointers to the values stay valid until their element is erased, and erased slots are
+*  reused through a free list.
+*
+*  The elements are read as std::pair<const Key&, T&>.
+*
+*    auto mymap = sel::slab_sorted_map<int, big_struct>();
+*    auto &value = mymap[1];
+*    mymap[0] = big_struct();        // value is still valid
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sel
+{
+    template <class Key, class T, class Allocator = std::allocator<T>>
+    class slab_sorted_map
+    {
+        template <class K, class U, class A, class Pred>
+        friend typename slab_sorted_map<K, U, A>::size_type erase_if(slab_sorted_map<K, U, A> &c, Pred pred);
+
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+
+        static const size_type block_size = 64;
+
+    private:
+        struct entry
+        {
+            Key key;
+            std::uint32_t index;
+        };
+
+        struct block
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[block_size];
+        };
+
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<entry> entry_allocator;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<block> block_allocator;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<block *> block_pointer_allocator;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t> index_allocator;
+
+        template <class Owner, class Mapped>
+        class basic_iterator {
+            friend class slab_sorted_map;
+            Owner *m_owner;
+            size_type m_index;
+
+            basic_iterator(Owner *owner, size_type index) : m_owner(owner), m_index(index) {}
+
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename slab_sorted_map::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::pair<const Key &, Mapped &> reference;
+
+            struct pointer
+            {
+                reference m_ref;
+
+                const reference *operator->() const
+                {
+                    return &m_ref;
+                }
+            };
+
+            basic_iterator() : m_owner(nullptr), m_index(0) {}
+
+            template <class O, class M>
+            basic_iterator(const basic_iterator<O,M> &other) : m_owner(other.m_owner), m_index(other.m_index) {}
+
+            reference operator*() const
+            {
+                auto &e = m_owner->m_container[m_index];
+                return reference(e.key, m_owner->value_at(e.index));
+            }
+
+            pointer operator->() const
+            {
+                return pointer{**this};
+            }
+
+            basic_iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                auto result = *this;
+                ++m_index;
+                return result;
+            }
+
+            basic_iterator &operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            basic_iterator operator--(int)
+            {
+                auto result = *this;
+                --m_index;
+                return result;
+            }
+
+            template <class O, class M>
+            bool operator==(const basic_iterator<O,M> &other) const
+            {
+                return m_index == other.m_index;
+            }
+
+            template <class O, class M>
+            bool operator!=(const basic_iterator<O,M> &other) const
+            {
+                return !(*this == other);
+            }
+
+            template <class O, class M>
+            friend class basic_iterator;
+        };
+
+    public:
+        typedef basic_iterator<slab_sorted_map, T> iterator;
+        typedef basic_iterator<const slab_sorted_map, const T> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        Allocator m_alloc;
+        std::vector<entry, entry_allocator> m_container;
+        std::vector<block *, block_pointer_allocator> m_blocks;
+        std::vector<std::uint32_t, index_allocator> m_free;
+        std::uint32_t m_used = 0;
+
+        T &value_at(std::uint32_t index) const
+        {
+            return *reinterpret_cast<T *>(&m_blocks[index / block_size]->slots[index % block_size]);
+        }
+
+        template <class... Args>
+        std::uint32_t construct(Args &&...args)
+        {
+            std::uint32_t index;
+            if (!m_free.empty())
+            {
+                index = m_free.back();
+            }
+            else
+            {
+                if (m_used >= max_size())
+                {
+                    throw std::length_error("slab_sorted_map exceeds max_size");
+                }
+                index = m_used;
+                if (index / block_size == m_blocks.size())
+                {
+                    if (m_blocks.size() == m_blocks.capacity())
+                    {
+                        m_blocks.reserve(2 * m_blocks.size() + 1);
+                    }
+                    auto alloc = block_allocator(m_alloc);
+                    m_blocks.push_back(std::allocator_traits<block_allocator>::allocate(alloc, 1));
+                }
+            }
+            std::allocator_traits<Allocator>::construct(m_alloc, &value_at(index), std::forward<Args>(args)...);
+            if (!m_free.empty())
+            {
+                m_free.pop_back();
+            }
+            else
+            {
+                ++m_used;
+            }
+            return index;
+        }
+
+        void destroy(std::uint32_t index)
+        {
+            std::allocator_traits<Allocator>::destroy(m_alloc, &value_at(index));
+            m_free.push_back(index);
+        }
+
+        template <class... Args>
+        iterator insert_at(size_type index, const Key &key, Args &&...args)
+        {
+            if (m_free.capacity() <= m_used)
+            {
+                m_free.reserve(std::max<size_type>(2 * m_free.capacity(), block_size));
+            }
+            auto slot = construct(std::forward<Args>(args)...);
+            try
+            {
+                m_container.insert(m_container.begin() + index, entry{key, slot});
+            }
+            catch (...)
+            {
+                destroy(slot);
+                throw;
+            }
+            return iterator(this, index);
+        }
+
+        size_type search_lower(const Key &key) const
+        {
+            return std::lower_bound(m_container.begin(), m_container.end(), key, [](const entry &e, const Key &k) {
+                return e.key < k;
+            }) - m_container.begin();
+        }
+
+        size_type search_upper(const Key &key) const
+        {
+            return std::upper_bound(m_container.begin(), m_container.end(), key, [](const Key &k, const entry &e) {
+                return k < e.key;
+            }) - m_container.begin();
+        }
+
+        size_type search(const Key &key) const
+        {
+            auto index = search_lower(key);
+            if (index != m_container.size() && !(key < m_container[index].key))
+            {
+                return index;
+            }
+            return m_container.size();
+        }
+
+        void release()
+        {
+            for (auto &e : m_container)
+            {
+                std::allocator_traits<Allocator>::destroy(m_alloc, &value_at(e.index));
+            }
+            auto alloc = block_allocator(m_alloc);
+            for (auto b : m_blocks)
+            {
+                std::allocator_traits<block_allocator>::deallocate(alloc, b, 1);
+            }
+            m_container.clear();
+            m_blocks.clear();
+            m_free.clear();
+            m_used = 0;
+        }
+
+    public:
+
+        slab_sorted_map() {}
+
+        explicit slab_sorted_map(const Allocator &alloc)
+            : m_alloc(alloc), m_container(entry_allocator(alloc)), m_blocks(block_pointer_allocator(alloc)), m_free(index_allocator(alloc))
+        {
+        }
+
+        template <class InputIt>
+        slab_sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : slab_sorted_map(alloc)
+        {
+            insert(first, last);
+        }
+
+        slab_sorted_map(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : slab_sorted_map(std::begin(init), std::end(init), alloc)
+        {
+        }
+
+        slab_sorted_map(const slab_sorted_map &other)
+            : slab_sorted_map(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_alloc))
+        {
+            m_container.reserve(other.size());
+            for (auto itr = other.cbegin(); itr != other.cend(); ++itr)
+            {
+                insert_at(m_container.size(), itr->first, itr->second);
+            }
+        }
+
+        slab_sorted_map(slab_sorted_map &&other) noexcept
+            : m_alloc(std::move(other.m_alloc)), m_container(std::move(other.m_container)), m_blocks(std::move(other.m_blocks)),
+              m_free(std::move(other.m_free)), m_used(other.m_used)
+        {
+            other.m_container.clear();
+            other.m_blocks.clear();
+            other.m_free.clear();
+            other.m_used = 0;
+        }
+
+        ~slab_sorted_map()
+        {
+            release();
+        }
+
+        slab_sorted_map &operator=(const slab_sorted_map &other)
+        {
+            if (this != &other)
+            {
+                auto copy = slab_sorted_map(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        slab_sorted_map &operator=(slab_sorted_map &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        slab_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_alloc;
+        }
+
+        T &at(const Key &key)
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+            {
+                throw std::out_of_range("failed to find key in slab_sorted_map");
+            }
+            return value_at(m_container[index].index);
+        }
+
+        const T &at(const Key &key) const
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+            {
+                throw std::out_of_range("failed to find key in slab_sorted_map");
+            }
+            return value_at(m_container[index].index);
+        }
+
+        T &operator[](const Key &key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(this, m_container.size());
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(this, m_container.size());
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(this, m_container.size());
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return std::min<size_type>(m_container.max_size(), 0xffffffffu);
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        // Number of values the allocated slab blocks can hold.
+        size_type slab_capacity() const noexcept
+        {
+            return m_blocks.size() * block_size;
+        }
+
+        // Number of erased slots waiting to be reused.
+        size_type free_slots() const noexcept
+        {
+            return m_free.size();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            release();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        iterator insert(const_iterator hint, const value_type &value)
+        {
+            return try_emplace(hint, value.first, value.second);
+        }
+
+        iterator insert(const_iterator hint, value_type &&value)
+        {
+            return try_emplace(hint, value.first, std::move(value.second));
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                try_emplace(cend(), first->first, first->second);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj)
+        {
+            auto index = search_lower(key);
+            if (index != m_container.size() && !(key < m_container[index].key))
+            {
+                value_at(m_container[index].index) = std::forward<M>(obj);
+                return std::make_pair(iterator(this, index), false);
+            }
+            return std::make_pair(insert_at(index, key, std::forward<M>(obj)), true);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            auto value = value_type(std::forward<Args>(args)...);
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args)
+        {
+            auto index = search_lower(key);
+            if (index != m_container.size() && !(key < m_container[index].key))
+            {
+                return std::make_pair(iterator(this, index), false);
+            }
+            return std::make_pair(insert_at(index, key, std::forward<Args>(args)...), true);
+        }
+
+        template <class... Args>
+        iterator try_emplace(const_iterator hint, const Key &key, Args &&...args)
+        {
+            auto index = hint.m_index;
+            if ((index == 0 || m_container[index - 1].key < key) && (index == m_container.size() || key < m_container[index].key))
+            {
+                return insert_at(index, key, std::forward<Args>(args)...);
+            }
+            return try_emplace(key, std::forward<Args>(args)...).first;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, std::next(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            for (auto i = first.m_index; i != last.m_index; ++i)
+            {
+                destroy(m_container[i].index);
+            }
+            m_container.erase(m_container.begin() + first.m_index, m_container.begin() + last.m_index);
+            return iterator(this, first.m_index);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+                return 0;
+            erase(const_iterator(this, index));
+            return 1;
+        }
+
+        void swap(slab_sorted_map &other) noexcept
+        {
+            using std::swap;
+            swap(m_alloc, other.m_alloc);
+            m_container.swap(other.m_container);
+            m_blocks.swap(other.m_blocks);
+            m_free.swap(other.m_free);
+            swap(m_used, other.m_used);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return search(key) == m_container.size() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            return iterator(this, search(key));
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return const_iterator(this, search(key));
+        }
+
+        bool contains(const Key &key) const
+        {
+            return search(key) != m_container.size();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return iterator(this, search_lower(key));
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return const_iterator(this, search_lower(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return iterator(this, search_upper(key));
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return const_iterator(this, search_upper(key));
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+    };
+
+    template <class Key, class T, class Allocator>
+    const typename slab_sorted_map<Key, T, Allocator>::size_type slab_sorted_map<Key, T, Allocator>::block_size;
+
+    template <class K, class U, class A>
+    bool operator==(const slab_sorted_map<K, U, A> &lhs, const slab_sorted_map<K, U, A> &rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (auto l = lhs.cbegin(), r = rhs.cbegin(); l != lhs.cend(); ++l, ++r)
+        {
+            if (l->first < r->first || r->first < l->first || !(l->second == r->second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class K, class U, class A>
+    bool operator!=(const slab_sorted_map<K, U, A> &lhs, const slab_sorted_map<K, U, A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class K, class U, class A>
+    void swap(slab_sorted_map<K, U, A> &lhs, slab_sorted_map<K, U, A> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class U, class A, class Pred>
+    typename slab_sorted_map<K, U, A>::size_type erase_if(slab_sorted_map<K, U, A> &c, Pred pred)
+    {
+        typedef typename slab_sorted_map<K, U, A>::iterator::reference reference;
+        auto &entries = c.m_container;
+        typename slab_sorted_map<K, U, A>::size_type kept = 0;
+        for (typename slab_sorted_map<K, U, A>::size_type i = 0; i != entries.size(); ++i)
+        {
+            if (pred(reference(entries[i].key, c.value_at(entries[i].index))))
+            {
+                c.destroy(entries[i].index);
+            }
+            else
+            {
+                if (kept != i)
+                {
+                    entries[kept] = std::move(entries[i]);
+                }
+                ++kept;
+            }
+        }
+        auto erased = entries.size() - kept;
+        entries.erase(entries.begin() + kept, entries.end());
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
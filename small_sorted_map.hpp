@@ -0,0 +1,631 @@
+/* small_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using a sorted vector with N elements of inline
+*  storage to implement std::map, so that small maps never touch the heap.
+*
+*  INSTALL
+*
+*  Copy 'n' paste the small_sorted_map.hpp and small_vector.hpp to your C++ project and include it.
+*
+*    #include "small_sorted_map.hpp"
+*
+*  USAGE
+*
+*  This map support the same functionalty as sel.sorted_map, with the inline capacity as the third template
+*  argument i.e. sel.small_sorted_map<uint16_t, uint32_t, 16>. Maps that are not larger than
+*  linear_search_limit are searched with a linear scan instead of a binary search.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "small_vector.hpp"
+
+namespace sel
+{
+    template <class Key, class T, std::size_t N, class Allocator = std::allocator<std::pair<Key,T>>>
+    class small_sorted_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename small_vector<value_type, N, Allocator>::iterator iterator;
+        typedef typename small_vector<value_type, N, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static constexpr size_type linear_search_limit = 16;
+
+    private:
+        template <class It>
+        static It search_lower(It first, It last, const Key &key)
+        {
+            if (last - first > static_cast<difference_type>(linear_search_limit))
+            {
+                return std::lower_bound(first, last, key, [](const value_type& vt, const Key& k) {
+                    return vt.first < k;
+                });
+            }
+            if (std::is_arithmetic<Key>::value)
+            {
+                difference_type index = 0;
+                for (auto itr = first; itr != last; ++itr)
+                {
+                    index += itr->first < key;
+                }
+                return first + index;
+            }
+            while (first != last && first->first < key)
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        template <class It>
+        static It search_upper(It first, It last, const Key &key)
+        {
+            if (last - first > static_cast<difference_type>(linear_search_limit))
+            {
+                return std::upper_bound(first, last, key, [](const Key& k, const value_type& vt) {
+                    return k < vt.first;
+                });
+            }
+            if (std::is_arithmetic<Key>::value)
+            {
+                difference_type index = 0;
+                for (auto itr = first; itr != last; ++itr)
+                {
+                    index += !(key < itr->first);
+                }
+                return first + index;
+            }
+            while (first != last && !(key < first->first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+    private:
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator==(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator!=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator<(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator<=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator>(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend bool operator>=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs);
+        template <class K, class V, std::size_t M, class A>
+        friend void swap(small_sorted_map<K,V,M,A> &lhs, small_sorted_map<K,V,M,A> &rhs);
+        small_vector<value_type, N, allocator_type> m_container;
+        float m_growth_factor = 0.0f;
+
+        template <class V>
+        iterator insert_at(const_iterator pos, V &&value)
+        {
+            if (m_growth_factor > 1.0f && m_container.size() == m_container.capacity())
+            {
+                auto index = std::distance(m_container.cbegin(), pos);
+                m_container.reserve(std::max<size_type>(m_container.size() + 1, m_container.size() * m_growth_factor));
+                pos = m_container.cbegin() + index;
+            }
+            return m_container.insert(pos, std::forward<V>(value));
+        }
+
+    public:
+
+        small_sorted_map() : m_container() {}
+
+        explicit small_sorted_map(const Allocator &alloc) : m_container(alloc) {}
+
+        template <class InputIt>
+        small_sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            m_container.reserve(std::distance(first, last));
+            for (auto itr = first; itr != last; ++itr)
+            {
+                insert(*itr);
+            }
+        }
+
+        small_sorted_map(std::initializer_list<std::pair<Key,T>> init, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            m_container.reserve(init.size());
+            for (auto itr = init.begin(); itr != init.end(); ++itr)
+            {
+                insert(*itr);
+            }
+        }
+
+        small_sorted_map(const small_sorted_map &other) = default;
+
+        small_sorted_map(const small_sorted_map &other, const Allocator &alloc) : m_container(other.m_container, alloc), m_growth_factor(other.m_growth_factor) {}
+
+        small_sorted_map(small_sorted_map &&other) = default;
+
+        small_sorted_map(small_sorted_map &&other, const Allocator &alloc) : m_container(std::move(other.m_container), alloc), m_growth_factor(other.m_growth_factor) {}
+
+        ~small_sorted_map() = default;
+
+        small_sorted_map &operator=(const small_sorted_map &other) = default;
+
+        small_sorted_map &operator=(small_sorted_map &&other) = default;
+
+        small_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            m_container.clear();
+            for (auto itr = std::begin(ilist); itr != std::end(ilist); ++itr)
+            {
+                insert(*itr);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        T& at(const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in small_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in small_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        T& operator[](const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                return insert(std::pair<Key,T>(key,T())).first->second;
+            }
+            return find_result->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                return insert(std::pair<Key,T>(key,T())).first->second;
+            }
+            return find_result->second;
+        }
+
+
+        iterator begin() noexcept
+        {
+            return m_container.begin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return m_container.rbegin();
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return m_container.rend();
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        float growth_factor() const noexcept
+        {
+            return m_growth_factor;
+        }
+
+        void growth_factor(float factor) noexcept
+        {
+            m_growth_factor = factor;
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            else
+            {
+                auto itr = insert_at(first, value);
+                return std::make_pair(itr, true);
+            }
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            else
+            {
+                auto itr = insert_at(first, std::move(value));
+                return std::make_pair(itr, true);
+            }
+        }
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
+            {
+                if (!(it->first < value.first) && !(value.first < it->first))
+                {
+                    return m_container.begin() + std::distance(m_container.cbegin(), it);
+                }
+                else if (it->first < value.first)
+                {
+                    return insert_at(it + 1, value);
+                }
+            }
+            return insert(value).first;
+        }
+
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
+            {
+                if (!(it->first < value.first) && !(value.first < it->first))
+                {
+                    return m_container.begin() + std::distance(m_container.cbegin(), it);
+                }
+                else if (it->first < value.first)
+                {
+                    return insert_at(it + 1, std::move(value));
+                }
+            }
+            return insert(value).first;
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            auto value = value_type{args...};
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            else
+            {
+                auto itr = insert_at(first, value);
+                return std::make_pair(itr, true);
+            }
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args &&...args)
+        {
+            auto value = value_type{args...};
+            for (const_iterator it = (hint - 1); it != (m_container.begin() - 1); --it)
+            {
+                if (!(it->first < value.first) && !(value.first < it->first))
+                {
+                    return m_container.begin() + std::distance(m_container.cbegin(), it);
+                }
+                else if (it->first < value.first)
+                {
+                    return insert_at(it + 1, value);
+                }
+            }
+            return emplace(value).first;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return m_container.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return m_container.erase(first, last);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto find_result = find(key);
+            if (find_result == m_container.end())
+                return 0;
+            m_container.erase(find_result);
+            return 1;
+        }
+
+        template <class InputIt>
+        size_type erase_keys(InputIt first, InputIt last)
+        {
+            auto keys = std::vector<Key>(first, last);
+            if (!std::is_sorted(keys.begin(), keys.end()))
+            {
+                std::sort(keys.begin(), keys.end());
+            }
+            auto write = m_container.begin();
+            auto read = m_container.begin();
+            size_type erased = 0;
+            for (auto itr = keys.begin(); itr != keys.end() && read != m_container.end(); ++itr)
+            {
+                auto pos = std::lower_bound(read, m_container.end(), *itr, [](const value_type& vt, const Key& k) {
+                    return vt.first < k;
+                });
+                if (pos == m_container.end() || *itr < pos->first)
+                {
+                    continue;
+                }
+                write = (write == read) ? pos : std::move(read, pos, write);
+                read = pos + 1;
+                ++erased;
+            }
+            if (erased > 0)
+            {
+                write = std::move(read, m_container.end(), write);
+                m_container.erase(write, m_container.end());
+            }
+            return erased;
+        }
+
+        void swap(small_sorted_map &other)
+        {
+            m_container.swap(other.m_container);
+            std::swap(m_growth_factor, other.m_growth_factor);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == m_container.cend() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            auto find_result = search_lower(m_container.begin(), m_container.end(), key);
+            if (!(find_result == m_container.end()) && !(key < find_result->first))
+            {
+                return find_result;
+            }
+            return m_container.end();
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto find_result = search_lower(m_container.begin(), m_container.end(), key);
+            if (!(find_result == m_container.cend()) && !(key < find_result->first))
+            {
+                return find_result;
+            }
+            return m_container.cend();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return search_lower(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return search_lower(m_container.cbegin(), m_container.cend(), key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return search_upper(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return search_upper(m_container.cbegin(), m_container.cend(), key);
+        }
+    };
+
+    template <class Key, class T, std::size_t N, class Allocator>
+    constexpr typename small_sorted_map<Key, T, N, Allocator>::size_type small_sorted_map<Key, T, N, Allocator>::linear_search_limit;
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator==(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container == rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator!=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container != rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator<(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container < rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator<=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container <= rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator>(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container > rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    bool operator>=(const small_sorted_map<K,V,M,A> &lhs, const small_sorted_map<K,V,M,A> &rhs)
+    {
+        return lhs.m_container >= rhs.m_container;
+    }
+
+    template <class K, class V, std::size_t M, class A>
+    void swap(small_sorted_map<K,V,M,A> &lhs, small_sorted_map<K,V,M,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class V, std::size_t M, class A, class Pred>
+    typename small_sorted_map<K,V,M,A>::size_type erase_if(small_sorted_map<K,V,M,A> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,520 @@
+/* small_vector.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with a std::vector like container that keeps up to N
+*  elements in inline storage and only allocates on the heap when it grows beyond that. It is the storage used
+*  by sel.small_sorted_set and sel.small_sorted_map.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the small_vector.hpp
+*  to your C++ project and include it.
+*
+*    #include "small_vector.hpp"
+*
+*  USAGE
+*
+*  The vector support the subset of [std::vector](https://en.cppreference.com/w/cpp/container/vector) that the
+*  sorted containers need, the iterators are plain pointers.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace sel
+{
+    template <class T, std::size_t N, class Allocator = std::allocator<T>>
+    class small_vector {
+        static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef value_type *pointer;
+        typedef const value_type *const_pointer;
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        typedef std::allocator_traits<Allocator> traits;
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+        T *m_data;
+        size_type m_size;
+        size_type m_capacity;
+        Allocator m_alloc;
+
+        T *inline_data() noexcept
+        {
+            return reinterpret_cast<T *>(m_inline);
+        }
+
+        const T *inline_data() const noexcept
+        {
+            return reinterpret_cast<const T *>(m_inline);
+        }
+
+        bool is_inline() const noexcept
+        {
+            return m_data == inline_data();
+        }
+
+        void destroy_all() noexcept
+        {
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                traits::destroy(m_alloc, m_data + i);
+            }
+            m_size = 0;
+        }
+
+        void release() noexcept
+        {
+            if (!is_inline())
+            {
+                traits::deallocate(m_alloc, m_data, m_capacity);
+                m_data = inline_data();
+                m_capacity = N;
+            }
+        }
+
+        void relocate(size_type new_cap)
+        {
+            T *new_data = new_cap <= N ? inline_data() : traits::allocate(m_alloc, new_cap);
+            if (new_data == m_data)
+            {
+                return;
+            }
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                traits::construct(m_alloc, new_data + i, std::move_if_noexcept(m_data[i]));
+                traits::destroy(m_alloc, m_data + i);
+            }
+            if (!is_inline())
+            {
+                traits::deallocate(m_alloc, m_data, m_capacity);
+            }
+            m_data = new_data;
+            m_capacity = new_cap <= N ? N : new_cap;
+        }
+
+        void steal(small_vector &other)
+        {
+            if (other.is_inline())
+            {
+                for (size_type i = 0; i < other.m_size; ++i)
+                {
+                    traits::construct(m_alloc, m_data + i, std::move(other.m_data[i]));
+                }
+                m_size = other.m_size;
+                other.destroy_all();
+            }
+            else
+            {
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.inline_data();
+                other.m_size = 0;
+                other.m_capacity = N;
+            }
+        }
+
+    public:
+
+        small_vector() : m_data(inline_data()), m_size(0), m_capacity(N), m_alloc() {}
+
+        explicit small_vector(const Allocator &alloc) : m_data(inline_data()), m_size(0), m_capacity(N), m_alloc(alloc) {}
+
+        small_vector(const small_vector &other)
+            : small_vector(traits::select_on_container_copy_construction(other.m_alloc))
+        {
+            assign(other.begin(), other.end());
+        }
+
+        small_vector(const small_vector &other, const Allocator &alloc) : small_vector(alloc)
+        {
+            assign(other.begin(), other.end());
+        }
+
+        small_vector(small_vector &&other) : small_vector(other.m_alloc)
+        {
+            steal(other);
+        }
+
+        small_vector(small_vector &&other, const Allocator &alloc) : small_vector(alloc)
+        {
+            if (m_alloc == other.m_alloc)
+            {
+                steal(other);
+            }
+            else
+            {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            }
+        }
+
+        ~small_vector()
+        {
+            destroy_all();
+            release();
+        }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other)
+        {
+            if (this != &other)
+            {
+                destroy_all();
+                if (m_alloc == other.m_alloc)
+                {
+                    release();
+                    steal(other);
+                }
+                else
+                {
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                }
+            }
+            return *this;
+        }
+
+        template <class InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            for (auto itr = first; itr != last; ++itr)
+            {
+                emplace_back(*itr);
+            }
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_alloc;
+        }
+
+        reference operator[](size_type pos)
+        {
+            return m_data[pos];
+        }
+
+        const_reference operator[](size_type pos) const
+        {
+            return m_data[pos];
+        }
+
+        reference front()
+        {
+            return m_data[0];
+        }
+
+        const_reference front() const
+        {
+            return m_data[0];
+        }
+
+        reference back()
+        {
+            return m_data[m_size - 1];
+        }
+
+        const_reference back() const
+        {
+            return m_data[m_size - 1];
+        }
+
+        T *data() noexcept
+        {
+            return m_data;
+        }
+
+        const T *data() const noexcept
+        {
+            return m_data;
+        }
+
+        iterator begin() noexcept
+        {
+            return m_data;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_data;
+        }
+
+        iterator end() noexcept
+        {
+            return m_data + m_size;
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return traits::max_size(m_alloc);
+        }
+
+        void reserve(size_type new_cap)
+        {
+            if (new_cap > m_capacity)
+            {
+                relocate(new_cap);
+            }
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        void shrink_to_fit()
+        {
+            if (!is_inline() && m_size < m_capacity)
+            {
+                relocate(m_size);
+            }
+        }
+
+        bool is_small() const noexcept
+        {
+            return is_inline();
+        }
+
+        void clear() noexcept
+        {
+            destroy_all();
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            auto index = pos - m_data;
+            T value(std::forward<Args>(args)...);
+            if (m_size == m_capacity)
+            {
+                relocate(m_capacity * 2);
+            }
+            if (index == static_cast<difference_type>(m_size))
+            {
+                traits::construct(m_alloc, m_data + m_size, std::move(value));
+            }
+            else
+            {
+                traits::construct(m_alloc, m_data + m_size, std::move(m_data[m_size - 1]));
+                std::move_backward(m_data + index, m_data + m_size - 1, m_data + m_size);
+                m_data[index] = std::move(value);
+            }
+            ++m_size;
+            return m_data + index;
+        }
+
+        iterator insert(const_iterator pos, const T &value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class... Args>
+        reference emplace_back(Args &&...args)
+        {
+            return *emplace(cend(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            traits::destroy(m_alloc, m_data + --m_size);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto index = first - m_data;
+            auto count = last - first;
+            if (count > 0)
+            {
+                std::move(m_data + index + count, m_data + m_size, m_data + index);
+                while (count-- > 0)
+                {
+                    pop_back();
+                }
+            }
+            return m_data + index;
+        }
+
+        void swap(small_vector &other)
+        {
+            auto tmp = std::move(other);
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    };
+
+    template <class T, std::size_t N, class A>
+    bool operator==(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, std::size_t N, class A>
+    bool operator!=(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    bool operator<(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, std::size_t N, class A>
+    bool operator<=(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    bool operator>(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class T, std::size_t N, class A>
+    bool operator>=(const small_vector<T,N,A> &lhs, const small_vector<T,N,A> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class T, std::size_t N, class A>
+    void swap(small_vector<T,N,A> &lhs, small_vector<T,N,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
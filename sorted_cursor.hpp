@@ -0,0 +1,184 @@
+/* sorted_cursor.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with the finger search cursor used by sel.sorted_set
+*  and sel.sorted_map.
+*
+*  INSTALL
+*
+*  The file is included by sorted_set.hpp and sorted_map.hpp, copy 'n' paste it next to them.
+*
+*  USAGE
+*
+*  A cursor is taken from a container with make_cursor() and remembers the position of its last lookup. The next
+*  lookup gallops from there towards the key, 1, 2, 4, ... elements at a time, before the binary search, so a
+*  jump of d elements costs O(log d) comparisons instead of O(log n). The cursor stores an index and stays
+*  usable when the container changes, only the speed of the next lookup depends on how far the key moved.
+*
+*    auto myset = sel::sorted_set<int>({1, 3, 5, 7, 9});
+*    auto cursor = myset.make_cursor();
+*    cursor.lower_bound(4);    // *result == 5
+*    cursor.find(7);           // two elements further
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+namespace sel
+{
+    template <class Owner, class Iterator>
+    class sorted_cursor
+    {
+        typedef typename Owner::key_type key_type;
+        typedef typename Owner::value_type value_type;
+
+        Owner *m_owner;
+        std::size_t m_index = 0;
+
+        template <class Before>
+        Iterator seek_if(Before before)
+        {
+            auto &container = m_owner->m_container;
+            std::size_t size = container.size();
+            std::size_t depth = 1;
+            std::size_t first = 0;
+            std::size_t last = 0;
+            m_index = std::min(m_index, size);
+            if (m_index < size && before(container[m_index]))
+            {
+                first = m_index + 1;
+                last = size;
+                for (std::size_t step = 1; m_index + step < size; step *= 2)
+                {
+                    ++depth;
+                    if (!before(container[m_index + step]))
+                    {
+                        last = m_index + step;
+                        break;
+                    }
+                    first = m_index + step + 1;
+                }
+            }
+            else
+            {
+                last = m_index;
+                for (std::size_t step = 1; last > 0; step *= 2)
+                {
+                    std::size_t probe = last > step ? last - step : 0;
+                    ++depth;
+                    if (before(container[probe]))
+                    {
+                        first = probe + 1;
+                        break;
+                    }
+                    last = probe;
+                }
+            }
+            auto result = std::partition_point(container.begin() + first, container.begin() + last, [&depth, &before](const value_type &vt) {
+                ++depth;
+                return before(vt);
+            });
+            m_owner->m_stats.on_search(depth);
+            m_index = result - container.begin();
+            return result;
+        }
+
+    public:
+        typedef Iterator iterator;
+
+        explicit sorted_cursor(Owner &owner) : m_owner(&owner) {}
+
+        iterator position() const
+        {
+            return m_owner->m_container.begin() + std::min(m_index, m_owner->m_container.size());
+        }
+
+        std::size_t index() const noexcept
+        {
+            return m_index;
+        }
+
+        void reset() noexcept
+        {
+            m_index = 0;
+        }
+
+        iterator lower_bound(const key_type &key)
+        {
+            return seek_if([&key](const value_type &vt) {
+                return Owner::key_of(vt) < key;
+            });
+        }
+
+        iterator upper_bound(const key_type &key)
+        {
+            return seek_if([&key](const value_type &vt) {
+                return !(key < Owner::key_of(vt));
+            });
+        }
+
+        iterator find(const key_type &key)
+        {
+            auto result = lower_bound(key);
+            if (result != m_owner->m_container.end() && !(key < Owner::key_of(*result)))
+            {
+                return result;
+            }
+            return m_owner->m_container.end();
+        }
+
+        // Moves the cursor to the first element not less than key and tells if that element is key.
+        bool seek(const key_type &key)
+        {
+            return find(key) != m_owner->m_container.end();
+        }
+    };
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
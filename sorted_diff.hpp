@@ -0,0 +1,252 @@
+/* sorted_diff.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that computes the difference between two snapshots of
+*  a sel.sorted_set or sel.sorted_map in one linear pass.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the sorted_diff.hpp
+*  to your C++ project and include it together with sorted_set.hpp or sorted_map.hpp.
+*
+*    #include "sorted_diff.hpp"
+*
+*  USAGE
+*
+*  diff(old, current, visitor) walks the sorted vectors of both containers in lockstep and calls
+*  visitor.added(element) for keys only in current, visitor.removed(element) for keys only in old and, for maps,
+*  visitor.changed(old_element, current_element) for keys whose mapped values differ by operator==. When the
+*  keys and values are trivially copyable, equal stretches are skipped with memcmp over blocks that double in
+*  size, so elements with the same bytes count as unchanged. It takes O(n + m) time and works on any two spans
+*  of sorted, unique elements. Maps and sets are told apart by the container's key_type, so a set of pairs is
+*  compared on whole elements. For spans diff() compares whole elements and diff_map() compares pairs on first.
+*
+*    struct printer
+*    {
+*        void added(const std::pair<int,int> &p) { std::cout << "+" << p.first << "\n"; }
+*        void removed(const std::pair<int,int> &p) { std::cout << "-" << p.first << "\n"; }
+*        void changed(const std::pair<int,int> &, const std::pair<int,int> &p) { std::cout << "~" << p.first << "\n"; }
+*    };
+*    auto counts = sel::diff(yesterday, today, printer());
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+#include "sorted_span.hpp"
+
+namespace sel
+{
+    struct diff_result
+    {
+        std::size_t added = 0;
+        std::size_t removed = 0;
+        std::size_t changed = 0;
+    };
+
+    namespace detail
+    {
+        template <class V>
+        struct diff_set_traits
+        {
+            static const bool bitwise = std::is_trivially_copyable<V>::value;
+
+            static const V &key(const V &v)
+            {
+                return v;
+            }
+
+            template <class Visitor>
+            static std::size_t compare_values(Visitor &, const V &, const V &)
+            {
+                return 0;
+            }
+        };
+
+        template <class K, class T>
+        struct diff_map_traits
+        {
+            static const bool bitwise = std::is_trivially_copyable<K>::value && std::is_trivially_copyable<T>::value;
+
+            static const K &key(const std::pair<K,T> &v)
+            {
+                return v.first;
+            }
+
+            template <class Visitor>
+            static std::size_t compare_values(Visitor &visitor, const std::pair<K,T> &old, const std::pair<K,T> &current)
+            {
+                if (old.second == current.second)
+                {
+                    return 0;
+                }
+                visitor.changed(old, current);
+                return 1;
+            }
+        };
+
+        // Length of the common prefix of a and b found by memcmp over doubling blocks, 0 for other types.
+        template <class V>
+        std::size_t diff_equal_prefix(const V *a, const V *b, std::size_t n, std::true_type)
+        {
+            std::size_t done = 0;
+            std::size_t step = 1;
+            while (step <= n - done && std::memcmp(static_cast<const void *>(a + done), static_cast<const void *>(b + done), step * sizeof(V)) == 0)
+            {
+                done += step;
+                step *= 2;
+            }
+            while (step > 1)
+            {
+                step /= 2;
+                if (step <= n - done && std::memcmp(static_cast<const void *>(a + done), static_cast<const void *>(b + done), step * sizeof(V)) == 0)
+                {
+                    done += step;
+                }
+            }
+            return done;
+        }
+
+        template <class V>
+        std::size_t diff_equal_prefix(const V *, const V *, std::size_t, std::false_type)
+        {
+            return 0;
+        }
+
+        template <class Traits, class V, class Visitor>
+        diff_result diff_spans(span<V> old, span<V> current, Visitor &visitor)
+        {
+            typedef Traits traits;
+            auto result = diff_result();
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < old.size() && j < current.size())
+            {
+                auto equal = detail::diff_equal_prefix(old.data() + i, current.data() + j, std::min(old.size() - i, current.size() - j),
+                                                       std::integral_constant<bool, traits::bitwise>());
+                i += equal;
+                j += equal;
+                if (i == old.size() || j == current.size())
+                {
+                    break;
+                }
+                auto &a = old[i];
+                auto &b = current[j];
+                if (traits::key(a) < traits::key(b))
+                {
+                    visitor.removed(a);
+                    ++result.removed;
+                    ++i;
+                }
+                else if (traits::key(b) < traits::key(a))
+                {
+                    visitor.added(b);
+                    ++result.added;
+                    ++j;
+                }
+                else
+                {
+                    result.changed += traits::compare_values(visitor, a, b);
+                    ++i;
+                    ++j;
+                }
+            }
+            for (; i < old.size(); ++i)
+            {
+                visitor.removed(old[i]);
+                ++result.removed;
+            }
+            for (; j < current.size(); ++j)
+            {
+                visitor.added(current[j]);
+                ++result.added;
+            }
+            return result;
+        }
+    }
+
+    template <class V, class Visitor>
+    diff_result diff(span<V> old, span<V> current, Visitor &&visitor)
+    {
+        return detail::diff_spans<detail::diff_set_traits<V>>(old, current, visitor);
+    }
+
+    template <class K, class T, class Visitor>
+    diff_result diff_map(span<std::pair<K,T>> old, span<std::pair<K,T>> current, Visitor &&visitor)
+    {
+        return detail::diff_spans<detail::diff_map_traits<K,T>>(old, current, visitor);
+    }
+
+    namespace detail
+    {
+        template <class V, class Visitor>
+        diff_result diff_elements(span<V> old, span<V> current, Visitor &visitor, std::true_type)
+        {
+            return diff(old, current, visitor);
+        }
+
+        template <class V, class Visitor>
+        diff_result diff_elements(span<V> old, span<V> current, Visitor &visitor, std::false_type)
+        {
+            return diff_map(old, current, visitor);
+        }
+    }
+
+    template <class Container, class Visitor>
+    diff_result diff(const Container &old, const Container &current, Visitor &&visitor)
+    {
+        return detail::diff_elements(old.as_span(), current.as_span(), visitor,
+                                     std::is_same<typename Container::key_type, typename Container::value_type>());
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
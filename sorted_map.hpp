@@ -15,6 +15,9 @@
 *  This map support the same functionalty as [std::map](https://en.cppreference.com/w/cpp/container/map) but
 *  using the namespace sel instead of std i.e. sel.sorted_map.
 *
+*  The const members only read, unless the map is instantiated with sel::container_stats, whose counters are
+*  also updated by const lookups.
+*
 *  LICENSE
 *
 *  Placed in the public domain and also MIT licensed.
@@ -28,9 +31,38 @@
 #include <vector>
 #include <algorithm>
 
+#include "sorted_stats.hpp"
+#include "sorted_cursor.hpp"
+#include "sorted_span.hpp"
+
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
+
 namespace sel
 {
-    template <class Key, class T, class Allocator = std::allocator<std::pair<Key,T>>>
+    enum class batch_op : unsigned char
+    {
+        upsert,
+        erase
+    };
+
+    template <class Key, class T>
+    struct batch_mutation
+    {
+        Key key;
+        batch_op op;
+        T value;
+    };
+
+    struct batch_result
+    {
+        std::size_t inserted = 0;
+        std::size_t updated = 0;
+        std::size_t erased = 0;
+    };
+
+    template <class Key, class T, class Allocator = std::allocator<std::pair<Key,T>>, class Stats = no_stats>
     class sorted_map {
     public:
         typedef Key key_type;
@@ -42,40 +74,116 @@ namespace sel
         typedef value_type &reference;
         typedef const value_type &const_reference;
         typedef typename std::allocator_traits<Allocator>::pointer pointer;
-        typedef typename std::allocator<Allocator>::const_pointer const_pointer;
-        typedef typename std::vector<value_type>::iterator iterator;
-        typedef typename std::vector<value_type>::const_iterator const_iterator;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
         typedef std::reverse_iterator<iterator> reverse_iterator;
         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef sorted_cursor<sorted_map, iterator> cursor;
+        typedef sorted_cursor<const sorted_map, const_iterator> const_cursor;
 
     private:
-        template <class K, class V, class A>
-        friend bool operator==(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool operator!=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool operator<(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool operator<=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool operator>(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool operator>=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs);
-        template <class K, class V, class A>
-        friend bool swap(sorted_map<K,V,A> &lhs, sorted_map<K,V,A> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator==(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator!=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator<(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator<=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator>(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend bool operator>=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs);
+        template <class K, class V, class A, class S>
+        friend void swap(sorted_map<K,V,A,S> &lhs, sorted_map<K,V,A,S> &rhs);
+        template <class O, class I>
+        friend class sorted_cursor;
         std::vector<std::pair<Key,T>,allocator_type> m_container;
+        mutable detail::stats_and_growth<Stats> m_stats;
+
+        template <class V>
+        iterator insert_at(const_iterator pos, V &&value)
+        {
+            auto index = std::distance(m_container.cbegin(), pos);
+            auto capacity = m_container.capacity();
+            if (m_stats.growth_factor > 1.0f && m_container.size() == capacity)
+            {
+                m_container.reserve(std::max<size_type>(m_container.size() + 1, m_container.size() * m_stats.growth_factor));
+                pos = m_container.cbegin() + index;
+            }
+            m_stats.on_shift(m_container.size() - index, (m_container.size() - index) * sizeof(value_type));
+            auto itr = m_container.insert(pos, std::forward<V>(value));
+            if (m_container.capacity() != capacity)
+            {
+                m_stats.on_reallocate();
+            }
+            return itr;
+        }
+
+        template <class V>
+        iterator insert_hint(const_iterator pos, V &&value)
+        {
+            m_stats.on_compare(2);
+            if ((pos == m_container.cbegin() || (pos - 1)->first < value.first) && (pos == m_container.cend() || value.first < pos->first))
+            {
+                m_stats.on_hint(true);
+                return insert_at(pos, std::forward<V>(value));
+            }
+            m_stats.on_hint(false);
+            return insert(std::forward<V>(value)).first;
+        }
+
+        iterator erase_at(const_iterator first, const_iterator last)
+        {
+            if (first != last)
+            {
+                auto moved = std::distance(last, m_container.cend());
+                m_stats.on_shift(moved, moved * sizeof(value_type));
+            }
+            return m_container.erase(first, last);
+        }
+
+        static const Key &key_of(const value_type &vt)
+        {
+            return vt.first;
+        }
+
+        template <class It>
+        It search_lower(It first, It last, const Key &key) const
+        {
+            size_type depth = 0;
+            auto result = std::lower_bound(first, last, key, [&depth](const value_type& vt, const Key& k) {
+                ++depth;
+                return vt.first < k;
+            });
+            m_stats.on_search(depth);
+            return result;
+        }
+
+        template <class It>
+        It search_upper(It first, It last, const Key &key) const
+        {
+            size_type depth = 0;
+            auto result = std::upper_bound(first, last, key, [&depth](const Key& k, const value_type& vt) {
+                ++depth;
+                return k < vt.first;
+            });
+            m_stats.on_search(depth);
+            return result;
+        }
 
     public:
 
-        sorted_map() : m_container({}) {}
+        sorted_map() : m_container() {}
 
         explicit sorted_map(const Allocator &alloc) : m_container(alloc) {}
 
         template <class InputIt>
         sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
-            : m_container(std::distance(first, last), std::pair<Key,T>(), alloc)
+            : m_container(alloc)
         {
-            m_container.clear();
+            m_container.reserve(std::distance(first, last));
             for (auto itr = first; itr != last; ++itr)
             {
                 insert(*itr);
@@ -83,9 +191,9 @@ namespace sel
         }
 
         sorted_map(std::initializer_list<std::pair<Key,T>> init, const Allocator &alloc = Allocator())
-            : m_container(std::distance(init.begin(), init.end()), std::pair<Key,T>(), alloc)
+            : m_container(alloc)
         {
-            m_container.clear();
+            m_container.reserve(init.size());
             for (auto itr = init.begin(); itr != init.end(); ++itr)
             {
                 insert(*itr);
@@ -94,23 +202,17 @@ namespace sel
 
         sorted_map(const sorted_map &other) = default;
 
-        sorted_map(const sorted_map &other, Allocator &alloc) : m_container(other.m_container, alloc) {}
+        sorted_map(const sorted_map &other, const Allocator &alloc) : m_container(other.m_container, alloc), m_stats(other.m_stats) {}
 
         sorted_map(sorted_map &&other) = default;
 
-        sorted_map(sorted_map &&other, Allocator &alloc) : m_container(other.m_container, alloc) {}
+        sorted_map(sorted_map &&other, const Allocator &alloc) : m_container(std::move(other.m_container), alloc), m_stats(other.m_stats) {}
 
         ~sorted_map() = default;
 
-        sorted_map &operator=(const sorted_map &other)
-        {
-            return m_container.operator=(other);
-        }
+        sorted_map &operator=(const sorted_map &other) = default;
 
-        sorted_map &operator=(sorted_map &&other)
-        {
-            return m_container.operator=(other);
-        }
+        sorted_map &operator=(sorted_map &&other) = default;
 
         sorted_map &operator=(std::initializer_list<value_type> ilist)
         {
@@ -219,6 +321,31 @@ namespace sel
             return m_container.max_size();
         }
 
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        float growth_factor() const noexcept
+        {
+            return m_stats.growth_factor;
+        }
+
+        void growth_factor(float factor) noexcept
+        {
+            m_stats.growth_factor = factor;
+        }
+
         void clear() noexcept
         {
             m_container.clear();
@@ -226,62 +353,40 @@ namespace sel
 
         std::pair<iterator, bool> insert(const value_type &value)
         {
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
-            if (!(first == m_container.end()) && !(value < *first))
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.insert(first, value);
+                auto itr = insert_at(first, value);
                 return std::make_pair(itr, true);
             }
         }
 
         std::pair<iterator, bool> insert(value_type &&value)
         {
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
-            if (!(first == m_container.end()) && !(value < *first))
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.insert(first, value);
+                auto itr = insert_at(first, std::move(value));
                 return std::make_pair(itr, true);
             }
         }
 
         iterator insert(const_iterator pos, const value_type &value)
         {
-            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    return m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.insert(it + 1, value);
-                }
-            }
-            return insert(value).first;
+            return insert_hint(pos, value);
         }
 
         iterator insert(const_iterator pos, value_type &&value)
         {
-            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.insert(it + 1, value);
-                }
-            }
-            return insert(value).first;
+            return insert_hint(pos, std::move(value));
         }
 
         template <class InputIt>
@@ -302,14 +407,14 @@ namespace sel
         std::pair<iterator, bool> emplace(Args &&...args)
         {
             auto value = value_type{args...};
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
-            if (!(first == m_container.end()) && !(value < *first))
+            auto first = search_lower(m_container.begin(), m_container.end(), value.first);
+            if (!(first == m_container.end()) && !(value.first < first->first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.emplace(first, value);
+                auto itr = insert_at(first, value);
                 return std::make_pair(itr, true);
             }
         }
@@ -317,29 +422,17 @@ namespace sel
         template <class... Args>
         iterator emplace_hint(const_iterator hint, Args &&...args)
         {
-            auto value = value_type{args...};
-            for (const_iterator it = (hint - 1); it != (m_container.begin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    return m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.emplace(it + 1, value);
-                }
-            }
-            return emplace(value).first;
+            return insert_hint(hint, value_type{args...});
         }
 
         iterator erase(const_iterator pos)
         {
-            return m_container.erase(pos);
+            return erase_at(pos, pos + 1);
         }
 
         iterator erase(const_iterator first, const_iterator last)
         {
-            return m_container.erase(first, last);
+            return erase_at(first, last);
         }
 
         size_type erase(const Key &key)
@@ -347,25 +440,197 @@ namespace sel
             auto find_result = find(key);
             if (find_result == m_container.end())
                 return 0;
-            m_container.erase(find_result);
+            erase_at(find_result, find_result + 1);
             return 1;
         }
 
+        template <class InputIt>
+        size_type erase_keys(InputIt first, InputIt last)
+        {
+            auto keys = std::vector<Key>(first, last);
+            if (!std::is_sorted(keys.begin(), keys.end()))
+            {
+                std::sort(keys.begin(), keys.end());
+            }
+            auto write = m_container.begin();
+            auto read = m_container.begin();
+            size_type erased = 0;
+            for (auto itr = keys.begin(); itr != keys.end() && read != m_container.end(); ++itr)
+            {
+                auto pos = search_lower(read, m_container.end(), *itr);
+                if (pos == m_container.end() || *itr < pos->first)
+                {
+                    continue;
+                }
+                if (write != read)
+                {
+                    m_stats.on_shift(pos - read, (pos - read) * sizeof(value_type));
+                }
+                write = (write == read) ? pos : std::move(read, pos, write);
+                read = pos + 1;
+                ++erased;
+            }
+            if (erased > 0)
+            {
+                m_stats.on_shift(m_container.end() - read, (m_container.end() - read) * sizeof(value_type));
+                write = std::move(read, m_container.end(), write);
+                m_container.erase(write, m_container.end());
+            }
+            return erased;
+        }
+
+        // Applies a batch of batch_mutation in one merge pass, the last mutation of a key wins.
+        template <class InputIt>
+        batch_result apply_batch(InputIt first, InputIt last)
+        {
+            typedef typename std::iterator_traits<InputIt>::value_type mutation;
+            auto batch = std::vector<mutation>(first, last);
+            auto result = batch_result();
+            if (batch.empty())
+            {
+                return result;
+            }
+            auto by_key = [](const mutation &lhs, const mutation &rhs) {
+                return lhs.key < rhs.key;
+            };
+            if (!std::is_sorted(batch.begin(), batch.end(), by_key))
+            {
+                std::stable_sort(batch.begin(), batch.end(), by_key);
+            }
+            auto merged = std::vector<value_type, Allocator>(m_container.get_allocator());
+            merged.reserve(m_container.size() + batch.size());
+            auto read = m_container.begin();
+            for (auto itr = batch.begin(); itr != batch.end(); ++itr)
+            {
+                if (itr + 1 != batch.end() && !(itr->key < (itr + 1)->key))
+                {
+                    continue;
+                }
+                auto pos = search_lower(read, m_container.end(), itr->key);
+                merged.insert(merged.end(), std::make_move_iterator(read), std::make_move_iterator(pos));
+                read = pos;
+                bool found = pos != m_container.end() && !(itr->key < pos->first);
+                if (found)
+                {
+                    ++read;
+                }
+                if (itr->op == batch_op::erase)
+                {
+                    result.erased += found ? 1 : 0;
+                    continue;
+                }
+                if (found)
+                {
+                    ++result.updated;
+                    pos->second = std::move(itr->value);
+                    merged.push_back(std::move(*pos));
+                }
+                else
+                {
+                    ++result.inserted;
+                    merged.push_back(value_type(std::move(itr->key), std::move(itr->value)));
+                }
+            }
+            merged.insert(merged.end(), std::make_move_iterator(read), std::make_move_iterator(m_container.end()));
+            m_stats.on_compare(batch.size());
+            m_stats.on_reallocate();
+            m_container.swap(merged);
+            return result;
+        }
+
+        void merge(sorted_map &source)
+        {
+            if (source.m_container.empty() || &source == this)
+            {
+                return;
+            }
+            if (m_container.empty() || m_container.back().first < source.m_container.front().first)
+            {
+                m_container.insert(m_container.end(), std::make_move_iterator(source.m_container.begin()),
+                                   std::make_move_iterator(source.m_container.end()));
+                source.m_container.clear();
+                return;
+            }
+            auto merged = std::vector<value_type, Allocator>(m_container.get_allocator());
+            auto duplicates = std::vector<value_type, Allocator>(source.m_container.get_allocator());
+            merged.reserve(m_container.size() + source.m_container.size());
+            auto lhs = m_container.begin();
+            auto rhs = source.m_container.begin();
+            while (lhs != m_container.end() && rhs != source.m_container.end())
+            {
+                if (rhs->first < lhs->first)
+                {
+                    merged.push_back(std::move(*rhs++));
+                }
+                else
+                {
+                    if (!(lhs->first < rhs->first))
+                    {
+                        duplicates.push_back(std::move(*rhs++));
+                    }
+                    merged.push_back(std::move(*lhs++));
+                }
+            }
+            merged.insert(merged.end(), std::make_move_iterator(lhs), std::make_move_iterator(m_container.end()));
+            merged.insert(merged.end(), std::make_move_iterator(rhs), std::make_move_iterator(source.m_container.end()));
+            m_stats.on_compare(merged.size() + duplicates.size());
+            m_stats.on_reallocate();
+            m_container.swap(merged);
+            source.m_container.swap(duplicates);
+        }
+
+        void merge(sorted_map &&source)
+        {
+            merge(source);
+        }
+
+        sorted_map split(const Key &key)
+        {
+            auto result = sorted_map(m_container.get_allocator());
+            auto first = search_lower(m_container.begin(), m_container.end(), key);
+            result.m_container.assign(std::make_move_iterator(first), std::make_move_iterator(m_container.end()));
+            m_container.erase(first, m_container.end());
+            return result;
+        }
+
+        // Keys of other that are already in this container are dropped, other is always left empty.
+        void join(sorted_map &&other)
+        {
+            if (m_container.empty() && m_container.get_allocator() == other.m_container.get_allocator())
+            {
+                m_container.swap(other.m_container);
+            }
+            else
+            {
+                merge(other);
+            }
+            other.m_container.clear();
+        }
+
         void swap(sorted_map &other)
         {
-            m_container.swap(other);
+            m_container.swap(other.m_container);
+            std::swap(m_stats, other.m_stats);
+        }
+
+        const Stats &stats() const noexcept
+        {
+            return m_stats;
+        }
+
+        void reset_stats() noexcept
+        {
+            m_stats.reset();
         }
 
         size_type count(const Key &key) const
         {
-            return std::binary_search(m_container.begin(), m_container.end(), key) ? 1 : 0;
+            return find(key) == m_container.cend() ? 0 : 1;
         }
 
         iterator find(const Key &key)
         {
-            auto find_result = std::lower_bound(m_container.begin(), m_container.end(), key, [](const value_type& vt, const Key& k) {
-                return vt.first < k;
-            });
+            auto find_result = search_lower(m_container.begin(), m_container.end(), key);
             if (!(find_result == m_container.end()) && !(key < find_result->first))
             {
                 return find_result;
@@ -375,9 +640,7 @@ namespace sel
 
         const_iterator find(const Key &key) const
         {
-            auto find_result = std::lower_bound(m_container.begin(), m_container.end(), key, [](const value_type& vt, const Key& k) {
-                return vt.first < k;
-            });
+            auto find_result = search_lower(m_container.begin(), m_container.end(), key);
             if (!(find_result == m_container.cend()) && !(key < find_result->first))
             {
                 return find_result;
@@ -387,16 +650,12 @@ namespace sel
 
         iterator lower_bound(const Key &key)
         {
-            return std::lower_bound(m_container.begin(), m_container.end(), key, [](const value_type& vt, const Key& k) {
-                return vt.first < k;
-            });
+            return search_lower(m_container.begin(), m_container.end(), key);
         }
 
         const_iterator lower_bound(const Key &key) const
         {
-            return std::lower_bound(m_container.cbegin(), m_container.cend(), key, [](const value_type& vt, const Key& k) {
-                return vt.first < k;
-            });
+            return search_lower(m_container.cbegin(), m_container.cend(), key);
         }
 
         std::pair<iterator, iterator> equal_range(const Key &key)
@@ -411,60 +670,111 @@ namespace sel
 
         iterator upper_bound(const Key &key)
         {
-            return std::upper_bound(m_container.begin(), m_container.end(), key, [](const Key& k, const value_type& vt) {
-                return k < vt.first;
-            });
+            return search_upper(m_container.begin(), m_container.end(), key);
         }
 
         const_iterator upper_bound(const Key &key) const
         {
-            return std::upper_bound(m_container.cbegin(), m_container.cend(), key, [](const Key& k, const value_type& vt) {
-                return k < vt.first;
-            });
+            return search_upper(m_container.cbegin(), m_container.cend(), key);
+        }
+
+        cursor make_cursor()
+        {
+            return cursor(*this);
+        }
+
+        const_cursor make_cursor() const
+        {
+            return const_cursor(*this);
+        }
+
+        const value_type *data() const noexcept
+        {
+            return m_container.data();
+        }
+
+        span<value_type> as_span() const noexcept
+        {
+            return span<value_type>(m_container.data(), m_container.size());
+        }
+
+        // The elements with keys in the closed range [lo, hi].
+        span<value_type> span_between(const Key &lo, const Key &hi) const
+        {
+            auto first = search_lower(m_container.cbegin(), m_container.cend(), lo);
+            auto last = search_upper(first, m_container.cend(), hi);
+            return span<value_type>(m_container.data() + (first - m_container.cbegin()), last - first);
+        }
+
+        strided_span<Key> keys_view() const noexcept
+        {
+            return m_container.empty() ? strided_span<Key>() : strided_span<Key>(&m_container.front().first, m_container.size(), sizeof(value_type));
+        }
+
+        strided_span<T> values_view() const noexcept
+        {
+            return m_container.empty() ? strided_span<T>() : strided_span<T>(&m_container.front().second, m_container.size(), sizeof(value_type));
         }
     };
 
-    template <class K, class V, class A>
-    bool operator==(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator==(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container == rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    bool operator!=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator!=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container != rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    bool operator<(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator<(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container < rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    bool operator<=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator<=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container <= rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    bool operator>(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator>(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container > rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    bool operator>=(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    bool operator>=(const sorted_map<K,V,A,S> &lhs, const sorted_map<K,V,A,S> &rhs)
     {
         return lhs.m_container >= rhs.m_container;
     }
 
-    template <class K, class V, class A>
-    void swap(const sorted_map<K,V,A> &lhs, const sorted_map<K,V,A> &rhs)
+    template <class K, class V, class A, class S>
+    void swap(sorted_map<K,V,A,S> &lhs, sorted_map<K,V,A,S> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class V, class A, class S, class Pred>
+    typename sorted_map<K,V,A,S>::size_type erase_if(sorted_map<K,V,A,S> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+
+#if __cplusplus >= 201703L
+    namespace pmr
     {
-        lhs.m_container.swap(rhs.m_container);
+        template <class Key, class T, class Stats = no_stats>
+        using sorted_map = sel::sorted_map<Key, T, std::pmr::polymorphic_allocator<std::pair<Key,T>>, Stats>;
     }
+#endif
 }
 
 /*
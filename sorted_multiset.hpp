@@ -0,0 +1,419 @@
+/* sorted_multiset.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::multiset
+*  to make it more cpu cache friendly.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the sorted_multiset.hpp
+*  to your C++ project and include it.
+*
+*    #include "sorted_multiset.hpp"
+*
+*  USAGE
+*
+*  This set support the same functionalty as [std::multiset](https://en.cppreference.com/w/cpp/container/multiset)
+*  but using the namespace sel instead of std i.e. sel.sorted_multiset. Equal elements keep their insertion order,
+*  count and equal_range are two binary searches no matter how many equal elements there are, and inserting a
+*  range sorts the new elements on their own and merges them into the container in one pass.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace sel
+{
+    template <class Key, class Allocator = std::allocator<Key>>
+    class sorted_multiset
+    {
+        template <class K, class A>
+        friend bool operator==(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator!=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator<(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator<=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator>(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend bool operator>=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs);
+        template <class K, class A>
+        friend void swap(sorted_multiset<K, A> &lhs, sorted_multiset<K, A> &rhs);
+        std::vector<Key, Allocator> m_container;
+
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        template <class V>
+        iterator insert_hint(const_iterator pos, V &&value)
+        {
+            if ((pos == m_container.cbegin() || !(value < *(pos - 1))) && (pos == m_container.cend() || value < *pos))
+            {
+                return m_container.insert(pos, std::forward<V>(value));
+            }
+            return insert(std::forward<V>(value));
+        }
+
+    public:
+
+        sorted_multiset() : m_container() {}
+
+        explicit sorted_multiset(const Allocator &alloc) : m_container(alloc) {}
+
+        template <class InputIt>
+        sorted_multiset(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            insert(first, last);
+        }
+
+        sorted_multiset(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : sorted_multiset(std::begin(init), std::end(init), alloc)
+        {
+        }
+
+        sorted_multiset(const sorted_multiset &other) = default;
+
+        sorted_multiset(const sorted_multiset &other, const Allocator &alloc) : m_container(other.m_container, alloc) {}
+
+        sorted_multiset(sorted_multiset &&other) = default;
+
+        sorted_multiset(sorted_multiset &&other, const Allocator &alloc) : m_container(std::move(other.m_container), alloc) {}
+
+        ~sorted_multiset() = default;
+
+        sorted_multiset &operator=(const sorted_multiset &other) = default;
+
+        sorted_multiset &operator=(sorted_multiset &&other) = default;
+
+        sorted_multiset &operator=(std::initializer_list<value_type> ilist)
+        {
+            m_container.clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        iterator begin() noexcept
+        {
+            return m_container.begin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return m_container.rbegin();
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return m_container.crbegin();
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return m_container.rend();
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return m_container.crend();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+        }
+
+        iterator insert(const value_type &value)
+        {
+            return m_container.insert(upper_bound(value), value);
+        }
+
+        iterator insert(value_type &&value)
+        {
+            auto pos = upper_bound(value);
+            return m_container.insert(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            return insert_hint(pos, value);
+        }
+
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            return insert_hint(pos, std::move(value));
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            auto middle = static_cast<difference_type>(m_container.size());
+            m_container.insert(m_container.end(), first, last);
+            std::stable_sort(m_container.begin() + middle, m_container.end());
+            std::inplace_merge(m_container.begin(), m_container.begin() + middle, m_container.end());
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        iterator emplace(Args &&...args)
+        {
+            return insert(value_type{std::forward<Args>(args)...});
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args &&...args)
+        {
+            return insert_hint(hint, value_type{std::forward<Args>(args)...});
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return m_container.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return m_container.erase(first, last);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto range = equal_range(key);
+            auto erased = std::distance(range.first, range.second);
+            m_container.erase(range.first, range.second);
+            return erased;
+        }
+
+        void swap(sorted_multiset &other)
+        {
+            m_container.swap(other.m_container);
+        }
+
+        size_type count(const Key &key) const
+        {
+            auto range = equal_range(key);
+            return std::distance(range.first, range.second);
+        }
+
+        iterator find(const Key &key)
+        {
+            auto first = lower_bound(key);
+            if (!(first == m_container.end()) && !(key < *first))
+            {
+                return first;
+            }
+            return m_container.end();
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto first = lower_bound(key);
+            if (!(first == m_container.cend()) && !(key < *first))
+            {
+                return first;
+            }
+            return m_container.cend();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return std::lower_bound(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return std::lower_bound(m_container.cbegin(), m_container.cend(), key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            auto first = lower_bound(key);
+            return std::make_pair(first, std::upper_bound(first, m_container.end(), key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            auto first = lower_bound(key);
+            return std::make_pair(first, std::upper_bound(first, m_container.cend(), key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return std::upper_bound(m_container.begin(), m_container.end(), key);
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return std::upper_bound(m_container.cbegin(), m_container.cend(), key);
+        }
+    };
+
+    template <class K, class A>
+    bool operator==(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container == rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator!=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container != rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator<(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container < rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator<=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container <= rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator>(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container > rhs.m_container;
+    }
+
+    template <class K, class A>
+    bool operator>=(const sorted_multiset<K, A> &lhs, const sorted_multiset<K, A> &rhs)
+    {
+        return lhs.m_container >= rhs.m_container;
+    }
+
+    template <class K, class A>
+    void swap(sorted_multiset<K, A> &lhs, sorted_multiset<K, A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class A, class Pred>
+    typename sorted_multiset<K, A>::size_type erase_if(sorted_multiset<K, A> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
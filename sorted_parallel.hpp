@@ -0,0 +1,225 @@
+/* sorted_parallel.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with parallel for_each, transform and reduce over the
+*  contiguous ranges of sel.sorted_set, sel.sorted_map and their variants.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the sorted_parallel.hpp
+*  to your C++ project, include it and link with the platform thread library (Threads::Threads in CMake).
+*
+*    #include "sorted_parallel.hpp"
+*
+*  USAGE
+*
+*  The algorithms take a pair of random access iterators, a whole container with begin() and end() or a sub
+*  range from lower_bound(a) and upper_bound(b). The range is cut into chunks that std::threads claim one at a
+*  time, so a slow chunk does not hold up the rest. parallel_reduce folds each chunk from left to right and then
+*  the chunk results in chunk order, set parallel_policy::chunk_size to get the same result for any number of
+*  threads even when the operation is not associative, like floating point addition.
+*
+*    auto mymap = sel::sorted_map<int, double>({{1, 0.5}, {2, 1.5}});
+*    auto total = sel::parallel_reduce(mymap.cbegin(), mymap.cend(), 0.0, [](double sum, const std::pair<int, double> &pair) {
+*        return sum + pair.second;
+*    }, [](double lhs, double rhs) { return lhs + rhs; });
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <iterator>
+#include <exception>
+#include <algorithm>
+
+namespace sel
+{
+    struct parallel_policy
+    {
+        // Number of threads including the calling one, 0 is std::thread::hardware_concurrency().
+        unsigned threads = 0;
+        // Elements per chunk, 0 picks about four chunks per thread but never less than min_chunk elements.
+        std::size_t chunk_size = 0;
+        std::size_t min_chunk = 16384;
+    };
+
+    namespace detail
+    {
+        inline unsigned parallel_threads(const parallel_policy &policy)
+        {
+            auto threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+            return std::max(threads, 1u);
+        }
+
+        inline std::size_t parallel_chunk(const parallel_policy &policy, std::size_t size)
+        {
+            if (policy.chunk_size != 0)
+            {
+                return policy.chunk_size;
+            }
+            return std::max<std::size_t>(std::max<std::size_t>(policy.min_chunk, 1), size / (parallel_threads(policy) * 4) + 1);
+        }
+
+        // Calls body(chunk, first, last) for every chunk of [0, size), the chunks are claimed by the threads in turn.
+        template <class Body>
+        void parallel_chunks(std::size_t size, const parallel_policy &policy, Body body)
+        {
+            auto chunk = parallel_chunk(policy, size);
+            auto chunks = (size + chunk - 1) / chunk;
+            auto threads = std::min<std::size_t>(parallel_threads(policy), chunks);
+            if (threads <= 1)
+            {
+                for (std::size_t i = 0; i < chunks; ++i)
+                {
+                    body(i, i * chunk, std::min(size, (i + 1) * chunk));
+                }
+                return;
+            }
+
+            std::atomic<std::size_t> next(0);
+            std::exception_ptr error;
+            std::atomic<bool> failed(false);
+            auto work = [&]() {
+                for (auto i = next++; i < chunks && !failed; i = next++)
+                {
+                    try
+                    {
+                        body(i, i * chunk, std::min(size, (i + 1) * chunk));
+                    }
+                    catch (...)
+                    {
+                        if (!failed.exchange(true))
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            };
+
+            auto workers = std::vector<std::thread>();
+            workers.reserve(threads - 1);
+            for (std::size_t i = 1; i < threads; ++i)
+            {
+                // When no more threads can be started the running ones and this thread claim the remaining chunks.
+                try
+                {
+                    workers.emplace_back(work);
+                }
+                catch (...)
+                {
+                    break;
+                }
+            }
+            work();
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    template <class RandomIt, class UnaryFunction>
+    void parallel_for_each(RandomIt first, RandomIt last, UnaryFunction f, const parallel_policy &policy = parallel_policy())
+    {
+        detail::parallel_chunks(std::distance(first, last), policy, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::for_each(first + begin, first + end, f);
+        });
+    }
+
+    template <class RandomIt, class OutputIt, class UnaryOperation>
+    OutputIt parallel_transform(RandomIt first, RandomIt last, OutputIt out, UnaryOperation op, const parallel_policy &policy = parallel_policy())
+    {
+        std::size_t size = std::distance(first, last);
+        detail::parallel_chunks(size, policy, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::transform(first + begin, first + end, out + begin, op);
+        });
+        return out + size;
+    }
+
+    // Folds every chunk with fold(T, element) starting from init and combines the chunk results with combine(T, T)
+    // in chunk order. init starts every chunk, so it must be the identity of combine.
+    template <class RandomIt, class T, class Fold, class Combine>
+    T parallel_reduce(RandomIt first, RandomIt last, T init, Fold fold, Combine combine, const parallel_policy &policy = parallel_policy())
+    {
+        std::size_t size = std::distance(first, last);
+        if (size == 0)
+        {
+            return init;
+        }
+        // Wrapped so the chunk results of a bool reduction do not share bytes in a std::vector<bool>.
+        struct partial
+        {
+            T value;
+        };
+        auto chunk = detail::parallel_chunk(policy, size);
+        auto partials = std::vector<partial>((size + chunk - 1) / chunk, partial{init});
+        detail::parallel_chunks(size, policy, [&](std::size_t index, std::size_t begin, std::size_t end) {
+            partials[index].value = std::accumulate(first + begin, first + end, init, fold);
+        });
+        auto result = std::move(partials.front().value);
+        for (std::size_t i = 1; i < partials.size(); ++i)
+        {
+            result = combine(std::move(result), std::move(partials[i].value));
+        }
+        return result;
+    }
+
+    template <class RandomIt, class T, class Combine>
+    T parallel_reduce(RandomIt first, RandomIt last, T init, Combine combine, const parallel_policy &policy = parallel_policy())
+    {
+        return parallel_reduce(first, last, init, combine, combine, policy);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
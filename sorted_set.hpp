@@ -15,6 +15,9 @@
 *  This map support the same functionalty as [std::set](https://en.cppreference.com/w/cpp/container/set) but
 *  using the namespace sel instead of std i.e. sel.sorted_map.
 *
+*  The const members only read, unless the set is instantiated with sel::container_stats, whose counters are
+*  also updated by const lookups.
+*
 *  LICENSE
 *
 *  Placed in the public domain and also MIT licensed.
@@ -27,26 +30,37 @@
 #include <vector>
 #include <algorithm>
 
+#include "sorted_stats.hpp"
+#include "sorted_cursor.hpp"
+#include "sorted_span.hpp"
+
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
+
 namespace sel
 {
-    template <class Key, class Allocator = std::allocator<Key>>
+    template <class Key, class Allocator = std::allocator<Key>, class Stats = no_stats>
     class sorted_set
     {
-        template <class K, class A>
-        friend bool operator==(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool operator!=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool operator<(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool operator<=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool operator>(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool operator>=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs);
-        template <class K, class A>
-        friend bool swap(sorted_set<K, A> &lhs, sorted_set<K, A> &rhs);
+        template <class K, class A, class S>
+        friend bool operator==(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend bool operator!=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend bool operator<(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend bool operator<=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend bool operator>(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend bool operator>=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs);
+        template <class K, class A, class S>
+        friend void swap(sorted_set<K, A, S> &lhs, sorted_set<K, A, S> &rhs);
+        template <class O, class I>
+        friend class sorted_cursor;
         std::vector<Key, Allocator> m_container;
+        mutable detail::stats_and_growth<Stats> m_stats;
 
     public:
         typedef Key key_type;
@@ -57,21 +71,97 @@ namespace sel
         typedef value_type &reference;
         typedef const value_type &const_reference;
         typedef typename std::allocator_traits<Allocator>::pointer pointer;
-        typedef typename std::allocator<Allocator>::const_pointer const_pointer;
-        typedef typename std::vector<Key>::iterator iterator;
-        typedef typename std::vector<Key>::const_iterator const_iterator;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
         typedef std::reverse_iterator<iterator> reverse_iterator;
         typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef sorted_cursor<sorted_set, iterator> cursor;
+        typedef sorted_cursor<const sorted_set, const_iterator> const_cursor;
+
+    private:
+        template <class V>
+        iterator insert_at(const_iterator pos, V &&value)
+        {
+            auto index = std::distance(m_container.cbegin(), pos);
+            auto capacity = m_container.capacity();
+            if (m_stats.growth_factor > 1.0f && m_container.size() == capacity)
+            {
+                m_container.reserve(std::max<size_type>(m_container.size() + 1, m_container.size() * m_stats.growth_factor));
+                pos = m_container.cbegin() + index;
+            }
+            m_stats.on_shift(m_container.size() - index, (m_container.size() - index) * sizeof(value_type));
+            auto itr = m_container.insert(pos, std::forward<V>(value));
+            if (m_container.capacity() != capacity)
+            {
+                m_stats.on_reallocate();
+            }
+            return itr;
+        }
 
-        sorted_set() : m_container({}) {}
+        template <class V>
+        iterator insert_hint(const_iterator pos, V &&value)
+        {
+            m_stats.on_compare(2);
+            if ((pos == m_container.cbegin() || *(pos - 1) < value) && (pos == m_container.cend() || value < *pos))
+            {
+                m_stats.on_hint(true);
+                return insert_at(pos, std::forward<V>(value));
+            }
+            m_stats.on_hint(false);
+            return insert(std::forward<V>(value)).first;
+        }
+
+        iterator erase_at(const_iterator first, const_iterator last)
+        {
+            if (first != last)
+            {
+                auto moved = std::distance(last, m_container.cend());
+                m_stats.on_shift(moved, moved * sizeof(value_type));
+            }
+            return m_container.erase(first, last);
+        }
+
+        static const Key &key_of(const value_type &vt)
+        {
+            return vt;
+        }
+
+        template <class It>
+        It search_lower(It first, It last, const Key &key) const
+        {
+            size_type depth = 0;
+            auto result = std::lower_bound(first, last, key, [&depth](const value_type &vt, const Key &k) {
+                ++depth;
+                return vt < k;
+            });
+            m_stats.on_search(depth);
+            return result;
+        }
+
+        template <class It>
+        It search_upper(It first, It last, const Key &key) const
+        {
+            size_type depth = 0;
+            auto result = std::upper_bound(first, last, key, [&depth](const Key &k, const value_type &vt) {
+                ++depth;
+                return k < vt;
+            });
+            m_stats.on_search(depth);
+            return result;
+        }
+
+    public:
+
+        sorted_set() : m_container() {}
 
         explicit sorted_set(const Allocator &alloc) : m_container(alloc) {}
 
         template <class InputIt>
         sorted_set(InputIt first, InputIt last, const Allocator &alloc = Allocator())
-            : m_container(std::distance(first, last), Key(), alloc)
+            : m_container(alloc)
         {
-            m_container.clear();
+            m_container.reserve(std::distance(first, last));
             for (auto itr = first; itr != last; ++itr)
             {
                 insert(*itr);
@@ -85,23 +175,17 @@ namespace sel
 
         sorted_set(const sorted_set &other) = default;
 
-        sorted_set(const sorted_set &other, Allocator &alloc) : m_container(other.m_container, alloc) {}
+        sorted_set(const sorted_set &other, const Allocator &alloc) : m_container(other.m_container, alloc), m_stats(other.m_stats) {}
 
         sorted_set(sorted_set &&other) = default;
 
-        sorted_set(sorted_set &&other, Allocator &alloc) : m_container(other.m_container, alloc) {}
+        sorted_set(sorted_set &&other, const Allocator &alloc) : m_container(std::move(other.m_container), alloc), m_stats(other.m_stats) {}
 
         ~sorted_set() = default;
 
-        sorted_set &operator=(const sorted_set &other)
-        {
-            return m_container.operator=(other);
-        }
+        sorted_set &operator=(const sorted_set &other) = default;
 
-        sorted_set &operator=(sorted_set &&other)
-        {
-            return m_container.operator=(other);
-        }
+        sorted_set &operator=(sorted_set &&other) = default;
 
         sorted_set &operator=(std::initializer_list<value_type> ilist)
         {
@@ -173,6 +257,31 @@ namespace sel
             return m_container.max_size();
         }
 
+        void reserve(size_type new_cap)
+        {
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            m_container.shrink_to_fit();
+        }
+
+        float growth_factor() const noexcept
+        {
+            return m_stats.growth_factor;
+        }
+
+        void growth_factor(float factor) noexcept
+        {
+            m_stats.growth_factor = factor;
+        }
+
         void clear() noexcept
         {
             m_container.clear();
@@ -180,62 +289,40 @@ namespace sel
 
         std::pair<iterator, bool> insert(const value_type &value)
         {
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
+            auto first = search_lower(m_container.begin(), m_container.end(), value);
             if (!(first == m_container.end()) && !(value < *first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.insert(first, value);
+                auto itr = insert_at(first, value);
                 return std::make_pair(itr, true);
             }
         }
 
         std::pair<iterator, bool> insert(value_type &&value)
         {
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
+            auto first = search_lower(m_container.begin(), m_container.end(), value);
             if (!(first == m_container.end()) && !(value < *first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.insert(first, value);
+                auto itr = insert_at(first, std::move(value));
                 return std::make_pair(itr, true);
             }
         }
 
         iterator insert(const_iterator pos, const value_type &value)
         {
-            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    return m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.insert(it + 1, value);
-                }
-            }
-            return insert(value).first;
+            return insert_hint(pos, value);
         }
 
         iterator insert(const_iterator pos, value_type &&value)
         {
-            for (const_iterator it = (pos - 1); it != (m_container.cbegin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.insert(it + 1, value);
-                }
-            }
-            return insert(value).first;
+            return insert_hint(pos, std::move(value));
         }
 
         template <class InputIt>
@@ -256,14 +343,14 @@ namespace sel
         std::pair<iterator, bool> emplace(Args &&...args)
         {
             auto value = value_type{args...};
-            auto first = std::lower_bound(std::begin(m_container), std::end(m_container), value);
+            auto first = search_lower(m_container.begin(), m_container.end(), value);
             if (!(first == m_container.end()) && !(value < *first))
             {
                 return std::make_pair(first, false);
             }
             else
             {
-                auto itr = m_container.emplace(first, value);
+                auto itr = insert_at(first, value);
                 return std::make_pair(itr, true);
             }
         }
@@ -271,29 +358,17 @@ namespace sel
         template <class... Args>
         iterator emplace_hint(const_iterator hint, Args &&...args)
         {
-            auto value = value_type{args...};
-            for (const_iterator it = (hint - 1); it != (m_container.begin() - 1); --it)
-            {
-                if (*it == value)
-                {
-                    return m_container.begin() + std::distance(m_container.cbegin(), it);
-                }
-                else if (*it < value)
-                {
-                    return m_container.emplace(it + 1, value);
-                }
-            }
-            return emplace(value).first;
+            return insert_hint(hint, value_type{args...});
         }
 
         iterator erase(const_iterator pos)
         {
-            return m_container.erase(pos);
+            return erase_at(pos, pos + 1);
         }
 
         iterator erase(const_iterator first, const_iterator last)
         {
-            return m_container.erase(first, last);
+            return erase_at(first, last);
         }
 
         size_type erase(const Key &key)
@@ -301,23 +376,138 @@ namespace sel
             auto find_result = find(key);
             if (find_result == m_container.end())
                 return 0;
-            m_container.erase(find_result);
+            erase_at(find_result, find_result + 1);
             return 1;
         }
 
+        template <class InputIt>
+        size_type erase_keys(InputIt first, InputIt last)
+        {
+            auto keys = std::vector<Key>(first, last);
+            if (!std::is_sorted(keys.begin(), keys.end()))
+            {
+                std::sort(keys.begin(), keys.end());
+            }
+            auto write = m_container.begin();
+            auto read = m_container.begin();
+            size_type erased = 0;
+            for (auto itr = keys.begin(); itr != keys.end() && read != m_container.end(); ++itr)
+            {
+                auto pos = search_lower(read, m_container.end(), *itr);
+                if (pos == m_container.end() || *itr < *pos)
+                {
+                    continue;
+                }
+                if (write != read)
+                {
+                    m_stats.on_shift(pos - read, (pos - read) * sizeof(value_type));
+                }
+                write = (write == read) ? pos : std::move(read, pos, write);
+                read = pos + 1;
+                ++erased;
+            }
+            if (erased > 0)
+            {
+                m_stats.on_shift(m_container.end() - read, (m_container.end() - read) * sizeof(value_type));
+                write = std::move(read, m_container.end(), write);
+                m_container.erase(write, m_container.end());
+            }
+            return erased;
+        }
+
+        void merge(sorted_set &source)
+        {
+            if (source.m_container.empty() || &source == this)
+            {
+                return;
+            }
+            if (m_container.empty() || m_container.back() < source.m_container.front())
+            {
+                m_container.insert(m_container.end(), std::make_move_iterator(source.m_container.begin()),
+                                   std::make_move_iterator(source.m_container.end()));
+                source.m_container.clear();
+                return;
+            }
+            auto merged = std::vector<value_type, Allocator>(m_container.get_allocator());
+            auto duplicates = std::vector<value_type, Allocator>(source.m_container.get_allocator());
+            merged.reserve(m_container.size() + source.m_container.size());
+            auto lhs = m_container.begin();
+            auto rhs = source.m_container.begin();
+            while (lhs != m_container.end() && rhs != source.m_container.end())
+            {
+                if (*rhs < *lhs)
+                {
+                    merged.push_back(std::move(*rhs++));
+                }
+                else
+                {
+                    if (!(*lhs < *rhs))
+                    {
+                        duplicates.push_back(std::move(*rhs++));
+                    }
+                    merged.push_back(std::move(*lhs++));
+                }
+            }
+            merged.insert(merged.end(), std::make_move_iterator(lhs), std::make_move_iterator(m_container.end()));
+            merged.insert(merged.end(), std::make_move_iterator(rhs), std::make_move_iterator(source.m_container.end()));
+            m_stats.on_compare(merged.size() + duplicates.size());
+            m_stats.on_reallocate();
+            m_container.swap(merged);
+            source.m_container.swap(duplicates);
+        }
+
+        void merge(sorted_set &&source)
+        {
+            merge(source);
+        }
+
+        sorted_set split(const Key &key)
+        {
+            auto result = sorted_set(m_container.get_allocator());
+            auto first = search_lower(m_container.begin(), m_container.end(), key);
+            result.m_container.assign(std::make_move_iterator(first), std::make_move_iterator(m_container.end()));
+            m_container.erase(first, m_container.end());
+            return result;
+        }
+
+        // Keys of other that are already in this container are dropped, other is always left empty.
+        void join(sorted_set &&other)
+        {
+            if (m_container.empty() && m_container.get_allocator() == other.m_container.get_allocator())
+            {
+                m_container.swap(other.m_container);
+            }
+            else
+            {
+                merge(other);
+            }
+            other.m_container.clear();
+        }
+
         void swap(sorted_set &other)
         {
-            m_container.swap(other);
+            m_container.swap(other.m_container);
+            std::swap(m_stats, other.m_stats);
+        }
+
+        const Stats &stats() const noexcept
+        {
+            return m_stats;
+        }
+
+        void reset_stats() noexcept
+        {
+            m_stats.reset();
         }
 
         size_type count(const Key &key) const
         {
-            return std::binary_search(m_container.begin(), m_container.end(), key) ? 1 : 0;
+            return find(key) == m_container.cend() ? 0 : 1;
         }
 
         iterator find(const Key &key)
         {
-            auto first = std::lower_bound(m_container.begin(), m_container.end(), key);
+            auto first = search_lower(m_container.begin(), m_container.end(), key);
             if (!(first == m_container.end()) && !(key < *first))
             {
                 return first;
@@ -327,7 +517,7 @@ namespace sel
 
         const_iterator find(const Key &key) const
         {
-            auto first = std::lower_bound(m_container.cbegin(), m_container.cend(), key);
+            auto first = search_lower(m_container.cbegin(), m_container.cend(), key);
             if (!(first == m_container.cend()) && !(key < *first))
             {
                 return first;
@@ -337,12 +527,12 @@ namespace sel
 
         iterator lower_bound(const Key &key)
         {
-            return std::lower_bound(std::begin(m_container), std::end(m_container), key);
+            return search_lower(m_container.begin(), m_container.end(), key);
         }
 
         const_iterator lower_bound(const Key &key) const
         {
-            return std::lower_bound(m_container.cbegin(), m_container.cend(), key);
+            return search_lower(m_container.cbegin(), m_container.cend(), key);
         }
 
         std::pair<iterator, iterator> equal_range(const Key &key)
@@ -357,56 +547,101 @@ namespace sel
 
         iterator upper_bound(const Key &key)
         {
-            return std::upper_bound(m_container.begin(), m_container.end(), key);
+            return search_upper(m_container.begin(), m_container.end(), key);
         }
 
         const_iterator upper_bound(const Key &key) const
         {
-            return std::upper_bound(m_container.cbegin(), m_container.cend(), key);
+            return search_upper(m_container.cbegin(), m_container.cend(), key);
+        }
+
+        cursor make_cursor()
+        {
+            return cursor(*this);
+        }
+
+        const_cursor make_cursor() const
+        {
+            return const_cursor(*this);
+        }
+
+        const value_type *data() const noexcept
+        {
+            return m_container.data();
+        }
+
+        span<value_type> as_span() const noexcept
+        {
+            return span<value_type>(m_container.data(), m_container.size());
+        }
+
+        // The elements with keys in the closed range [lo, hi].
+        span<value_type> span_between(const Key &lo, const Key &hi) const
+        {
+            auto first = search_lower(m_container.cbegin(), m_container.cend(), lo);
+            auto last = search_upper(first, m_container.cend(), hi);
+            return span<value_type>(m_container.data() + (first - m_container.cbegin()), last - first);
         }
     };
 
-    template <class K, class A>
-    bool operator==(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator==(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container == rhs.m_container;
     }
 
-    template <class K, class A>
-    bool operator!=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator!=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container != rhs.m_container;
     }
 
-    template <class K, class A>
-    bool operator<(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator<(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container < rhs.m_container;
     }
 
-    template <class K, class A>
-    bool operator<=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator<=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container <= rhs.m_container;
     }
 
-    template <class K, class A>
-    bool operator>(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator>(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container > rhs.m_container;
     }
 
-    template <class K, class A>
-    bool operator>=(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    bool operator>=(const sorted_set<K, A, S> &lhs, const sorted_set<K, A, S> &rhs)
     {
         return lhs.m_container >= rhs.m_container;
     }
 
-    template <class K, class A>
-    void swap(const sorted_set<K, A> &lhs, const sorted_set<K, A> &rhs)
+    template <class K, class A, class S>
+    void swap(sorted_set<K, A, S> &lhs, sorted_set<K, A, S> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class A, class S, class Pred>
+    typename sorted_set<K, A, S>::size_type erase_if(sorted_set<K, A, S> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+
+#if __cplusplus >= 201703L
+    namespace pmr
     {
-        lhs.m_container.swap(rhs.m_container);
+        template <class Key, class Stats = no_stats>
+        using sorted_set = sel::sorted_set<Key, std::pmr::polymorphic_allocator<Key>, Stats>;
     }
+#endif
 }
 
 /*
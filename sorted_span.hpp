@@ -0,0 +1,337 @@
+/* sorted_span.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with the read only views that sel.sorted_set and
+*  sel.sorted_map hand out over their sorted vector.
+*
+*  INSTALL
+*
+*  The file is included by sorted_set.hpp and sorted_map.hpp, copy 'n' paste it next to them.
+*
+*  USAGE
+*
+*  sel.span is a pointer and a size over contiguous elements, sel.strided_span steps a fixed number of bytes
+*  between the elements, which is how the keys or the values of a sorted_map are laid out inside its pairs.
+*  visit_blocks() calls a function with consecutive sub spans of at most block_size elements, for kernels that
+*  work on a fixed number of elements at a time. The views are invalidated by any change of the container.
+*
+*    auto myset = sel::sorted_set<float>({3.0f, 1.0f, 2.0f});
+*    auto keys = myset.span_between(1.5f, 3.0f);    // 2.0f, 3.0f without copying
+*    kernel(keys.data(), keys.size());
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+namespace sel
+{
+    template <class T>
+    class span
+    {
+        const T *m_data = nullptr;
+        std::size_t m_size = 0;
+
+    public:
+        typedef T element_type;
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef const T *iterator;
+        typedef const T *const_iterator;
+
+        span() noexcept {}
+
+        span(const T *data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+
+        const T *data() const noexcept
+        {
+            return m_data;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type size_bytes() const noexcept
+        {
+            return m_size * sizeof(T);
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        const T &operator[](size_type index) const
+        {
+            return m_data[index];
+        }
+
+        const T &front() const
+        {
+            return m_data[0];
+        }
+
+        const T &back() const
+        {
+            return m_data[m_size - 1];
+        }
+
+        iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        span subspan(size_type offset, size_type count) const
+        {
+            offset = std::min(offset, m_size);
+            return span(m_data + offset, std::min(count, m_size - offset));
+        }
+
+#if __cplusplus >= 202002L
+        operator std::span<const T>() const noexcept
+        {
+            return std::span<const T>(m_data, m_size);
+        }
+#endif
+    };
+
+    template <class T>
+    class strided_span
+    {
+        const char *m_data = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_stride = sizeof(T);
+
+    public:
+        class iterator
+        {
+            const char *m_ptr = nullptr;
+            std::size_t m_stride = 0;
+
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T *pointer;
+            typedef const T &reference;
+
+            iterator() {}
+
+            iterator(const char *ptr, std::size_t stride) : m_ptr(ptr), m_stride(stride) {}
+
+            reference operator*() const
+            {
+                return *reinterpret_cast<const T *>(m_ptr);
+            }
+
+            pointer operator->() const
+            {
+                return reinterpret_cast<const T *>(m_ptr);
+            }
+
+            reference operator[](difference_type n) const
+            {
+                return *(*this + n);
+            }
+
+            iterator &operator++()
+            {
+                m_ptr += m_stride;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto result = *this;
+                m_ptr += m_stride;
+                return result;
+            }
+
+            iterator &operator--()
+            {
+                m_ptr -= m_stride;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                auto result = *this;
+                m_ptr -= m_stride;
+                return result;
+            }
+
+            iterator &operator+=(difference_type n)
+            {
+                m_ptr += n * static_cast<difference_type>(m_stride);
+                return *this;
+            }
+
+            iterator &operator-=(difference_type n)
+            {
+                m_ptr -= n * static_cast<difference_type>(m_stride);
+                return *this;
+            }
+
+            iterator operator+(difference_type n) const
+            {
+                return iterator(*this) += n;
+            }
+
+            friend iterator operator+(difference_type n, const iterator &it)
+            {
+                return it + n;
+            }
+
+            iterator operator-(difference_type n) const
+            {
+                return iterator(*this) -= n;
+            }
+
+            difference_type operator-(const iterator &other) const
+            {
+                return m_stride == 0 ? 0 : (m_ptr - other.m_ptr) / static_cast<difference_type>(m_stride);
+            }
+
+            bool operator==(const iterator &other) const { return m_ptr == other.m_ptr; }
+            bool operator!=(const iterator &other) const { return m_ptr != other.m_ptr; }
+            bool operator<(const iterator &other) const { return m_ptr < other.m_ptr; }
+            bool operator<=(const iterator &other) const { return m_ptr <= other.m_ptr; }
+            bool operator>(const iterator &other) const { return m_ptr > other.m_ptr; }
+            bool operator>=(const iterator &other) const { return m_ptr >= other.m_ptr; }
+        };
+
+        typedef T element_type;
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef iterator const_iterator;
+
+        strided_span() noexcept {}
+
+        // stride is the distance in bytes from one element to the next.
+        strided_span(const T *data, std::size_t size, std::size_t stride) noexcept
+            : m_data(reinterpret_cast<const char *>(data)), m_size(size), m_stride(stride)
+        {
+        }
+
+        const T *data() const noexcept
+        {
+            return reinterpret_cast<const T *>(m_data);
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type stride() const noexcept
+        {
+            return m_stride;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        const T &operator[](size_type index) const
+        {
+            return *reinterpret_cast<const T *>(m_data + index * m_stride);
+        }
+
+        const T &front() const
+        {
+            return (*this)[0];
+        }
+
+        const T &back() const
+        {
+            return (*this)[m_size - 1];
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator(m_data, m_stride);
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator(m_data + m_size * m_stride, m_stride);
+        }
+
+        strided_span subspan(size_type offset, size_type count) const
+        {
+            offset = std::min(offset, m_size);
+            return strided_span(reinterpret_cast<const T *>(m_data + offset * m_stride), std::min(count, m_size - offset), m_stride);
+        }
+    };
+
+    // Calls f(view) for consecutive sub views of at most block_size elements, the last one may be shorter.
+    template <class View, class Function>
+    void visit_blocks(const View &view, std::size_t block_size, Function f)
+    {
+        block_size = std::max<std::size_t>(block_size, 1);
+        for (std::size_t offset = 0; offset < view.size(); offset += block_size)
+        {
+            f(view.subspan(offset, block_size));
+        }
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,156 @@
+/* sorted_stats.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library with the instrumentation policies used by sel.sorted_set
+*  and sel.sorted_map.
+*
+*  INSTALL
+*
+*  The file is included by sorted_set.hpp and sorted_map.hpp, copy 'n' paste it next to them.
+*
+*  USAGE
+*
+*  The policy is the last template argument of the containers. The default sel.no_stats does nothing and is
+*  optimized away, sel.container_stats counts the work the container does and can be read and reset through
+*  stats() and reset_stats().
+*
+*    auto myset = sel::sorted_set<int, std::allocator<int>, sel::container_stats>({3, 1, 2});
+*    myset.find(2);
+*    std::cout << myset.stats().comparisons << " comparisons, " << myset.stats().bytes_shifted << " bytes shifted";
+*    myset.reset_stats();
+*
+*  A custom policy is any default constructible, non-final type with the same member functions as sel.no_stats.
+*  The containers derive their growth factor holder from the policy, so an empty policy adds no size.
+*
+*  With sel.container_stats every lookup writes the counters, const ones included, so a container shared between
+*  threads must then be locked like for a write. With sel.no_stats the const members only read.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+namespace sel
+{
+    struct no_stats
+    {
+        void on_search(std::size_t) noexcept {}
+        void on_compare(std::size_t) noexcept {}
+        void on_shift(std::size_t, std::size_t) noexcept {}
+        void on_reallocate() noexcept {}
+        void on_hint(bool) noexcept {}
+        void reset() noexcept {}
+    };
+
+    struct container_stats
+    {
+        std::size_t comparisons = 0;
+        std::size_t searches = 0;
+        std::size_t max_search_depth = 0;
+        std::size_t elements_moved = 0;
+        std::size_t bytes_shifted = 0;
+        std::size_t reallocations = 0;
+        std::size_t hint_hits = 0;
+        std::size_t hint_misses = 0;
+
+        double average_search_depth() const noexcept
+        {
+            return searches == 0 ? 0.0 : static_cast<double>(search_comparisons) / searches;
+        }
+
+        void on_search(std::size_t depth) noexcept
+        {
+            ++searches;
+            comparisons += depth;
+            search_comparisons += depth;
+            max_search_depth = std::max(max_search_depth, depth);
+        }
+
+        void on_compare(std::size_t count) noexcept
+        {
+            comparisons += count;
+        }
+
+        void on_shift(std::size_t elements, std::size_t bytes) noexcept
+        {
+            elements_moved += elements;
+            bytes_shifted += bytes;
+        }
+
+        void on_reallocate() noexcept
+        {
+            ++reallocations;
+        }
+
+        void on_hint(bool hit) noexcept
+        {
+            ++(hit ? hint_hits : hint_misses);
+        }
+
+        void reset() noexcept
+        {
+            *this = container_stats();
+        }
+
+    private:
+        std::size_t search_comparisons = 0;
+    };
+
+    namespace detail
+    {
+        // The growth factor of a container stored next to its statistics policy, derived from it so an empty
+        // policy takes no space.
+        template <class Stats>
+        struct stats_and_growth : Stats
+        {
+            float growth_factor = 0.0f;
+        };
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
@@ -0,0 +1,352 @@
+/* sorted_trace.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that records the operations done on a sel.sorted_set,
+*  sel.sorted_map or any container with the same interface to a compact binary trace.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the sorted_trace.hpp
+*  to your C++ project and include it.
+*
+*    #include "sorted_trace.hpp"
+*
+*  USAGE
+*
+*  Wrap the container in a sel.traced_container to opt in. Inserts, erases, finds, lower_bound, upper_bound and
+*  clear are forwarded to the container and written to the trace_writer, everything else is reached through
+*  container(). Keys must be integral. A record is one byte with the operation followed by the key as a zigzag
+*  varint, an insert with a hint also stores the key at the hint so the replay can find the same position.
+*
+*    std::ofstream file("ops.trace", std::ios::binary);
+*    auto writer = sel::trace_writer(file);
+*    auto myset = sel::traced_container<sel::sorted_set<int>>(writer);
+*    myset.insert(myset.end(), 1);
+*    myset.find(1);
+*
+*  The sorted_container_replay program reads a trace back with sel.trace_reader and replays it against the
+*  containers of this library and std::map.
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sel
+{
+    enum class trace_op : unsigned char
+    {
+        insert,
+        insert_hint,
+        erase,
+        find,
+        lower_bound,
+        upper_bound,
+        clear
+    };
+
+    struct trace_record
+    {
+        trace_op op = trace_op::insert;
+        std::int64_t key = 0;
+        bool hint_end = false;
+        std::int64_t hint = 0;
+    };
+
+    static const char trace_magic[8] = {'S', 'E', 'L', 'T', 'R', 'A', 'C', '1'};
+
+    class trace_writer
+    {
+        std::ostream *m_out;
+        std::uint64_t m_count = 0;
+
+        void put_varint(std::int64_t value)
+        {
+            auto zigzag = (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+            char bytes[10];
+            int size = 0;
+            do
+            {
+                bytes[size++] = static_cast<char>((zigzag & 0x7f) | (zigzag > 0x7f ? 0x80 : 0));
+                zigzag >>= 7;
+            } while (zigzag != 0);
+            m_out->write(bytes, size);
+        }
+
+    public:
+        explicit trace_writer(std::ostream &out) : m_out(&out)
+        {
+            m_out->write(trace_magic, sizeof(trace_magic));
+        }
+
+        void write(const trace_record &record)
+        {
+            m_out->put(static_cast<char>(static_cast<unsigned char>(record.op) | (record.hint_end ? 0x10 : 0)));
+            if (record.op != trace_op::clear)
+            {
+                put_varint(record.key);
+            }
+            if (record.op == trace_op::insert_hint && !record.hint_end)
+            {
+                put_varint(record.hint);
+            }
+            ++m_count;
+        }
+
+        std::uint64_t count() const noexcept
+        {
+            return m_count;
+        }
+    };
+
+    class trace_reader
+    {
+        std::istream *m_in;
+
+        bool get_varint(std::int64_t &value)
+        {
+            std::uint64_t zigzag = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                auto byte = m_in->get();
+                if (byte == std::istream::traits_type::eof())
+                {
+                    return false;
+                }
+                zigzag |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    value = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    public:
+        explicit trace_reader(std::istream &in) : m_in(&in)
+        {
+            char magic[sizeof(trace_magic)] = {};
+            m_in->read(magic, sizeof(magic));
+            if (!std::equal(magic, magic + sizeof(magic), trace_magic))
+            {
+                throw std::runtime_error("not a sorted container trace");
+            }
+        }
+
+        // Reads the next record, false at the end of the trace.
+        bool read(trace_record &record)
+        {
+            auto byte = m_in->get();
+            if (byte == std::istream::traits_type::eof())
+            {
+                return false;
+            }
+            if ((byte & 0x0f) > static_cast<int>(trace_op::clear))
+            {
+                throw std::runtime_error("corrupt sorted container trace");
+            }
+            record = trace_record();
+            record.op = static_cast<trace_op>(byte & 0x0f);
+            record.hint_end = (byte & 0x10) != 0;
+            if (record.op != trace_op::clear && !get_varint(record.key))
+            {
+                throw std::runtime_error("truncated sorted container trace");
+            }
+            if (record.op == trace_op::insert_hint && !record.hint_end && !get_varint(record.hint))
+            {
+                throw std::runtime_error("truncated sorted container trace");
+            }
+            return true;
+        }
+    };
+
+    template <class Container>
+    class traced_container
+    {
+        static_assert(std::is_integral<typename Container::key_type>::value, "traced_container needs an integral key");
+
+        Container m_container;
+        trace_writer *m_writer;
+
+        template <class K>
+        static std::int64_t key_of(const K &key)
+        {
+            return static_cast<std::int64_t>(key);
+        }
+
+        template <class K, class T>
+        static std::int64_t key_of(const std::pair<K, T> &value)
+        {
+            return static_cast<std::int64_t>(value.first);
+        }
+
+        void record(trace_op op, std::int64_t key)
+        {
+            auto r = trace_record();
+            r.op = op;
+            r.key = key;
+            m_writer->write(r);
+        }
+
+    public:
+        typedef typename Container::key_type key_type;
+        typedef typename Container::value_type value_type;
+        typedef typename Container::size_type size_type;
+        typedef typename Container::iterator iterator;
+        typedef typename Container::const_iterator const_iterator;
+
+        explicit traced_container(trace_writer &writer, Container container = Container())
+            : m_container(std::move(container)), m_writer(&writer)
+        {
+        }
+
+        Container &container() noexcept
+        {
+            return m_container;
+        }
+
+        const Container &container() const noexcept
+        {
+            return m_container;
+        }
+
+        iterator begin() noexcept
+        {
+            return m_container.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        void clear()
+        {
+            record(trace_op::clear, 0);
+            m_container.clear();
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            record(trace_op::insert, key_of(value));
+            return m_container.insert(value);
+        }
+
+        iterator insert(const_iterator hint, const value_type &value)
+        {
+            auto r = trace_record();
+            r.op = trace_op::insert_hint;
+            r.key = key_of(value);
+            r.hint_end = hint == m_container.cend();
+            r.hint = r.hint_end ? 0 : key_of(*hint);
+            m_writer->write(r);
+            return m_container.insert(hint, value);
+        }
+
+        template <class C = Container>
+        typename C::mapped_type &operator[](const key_type &key)
+        {
+            record(trace_op::insert, key_of(key));
+            return m_container[key];
+        }
+
+        size_type erase(const key_type &key)
+        {
+            record(trace_op::erase, key_of(key));
+            return m_container.erase(key);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            record(trace_op::erase, key_of(*pos));
+            return m_container.erase(pos);
+        }
+
+        iterator find(const key_type &key)
+        {
+            record(trace_op::find, key_of(key));
+            return m_container.find(key);
+        }
+
+        size_type count(const key_type &key)
+        {
+            record(trace_op::find, key_of(key));
+            return m_container.count(key);
+        }
+
+        iterator lower_bound(const key_type &key)
+        {
+            record(trace_op::lower_bound, key_of(key));
+            return m_container.lower_bound(key);
+        }
+
+        iterator upper_bound(const key_type &key)
+        {
+            record(trace_op::upper_bound, key_of(key));
+            return m_container.upper_bound(key);
+        }
+    };
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
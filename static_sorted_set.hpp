@@ -0,0 +1,262 @@
+/* static_sorted_set.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++14 compatible library that implement the lookup part of std::set on a fixed
+*  size array that is sorted at compile time.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the static_sorted_set.hpp
+*  to your C++ project and include it.
+*
+*    #include "static_sorted_set.hpp"
+*
+*  USAGE
+*
+*  The set is built once from an array of keys in any order, the keys are sorted and checked for duplicates by
+*  the constexpr constructor. A constexpr set needs no construction or allocation at runtime and can be placed
+*  in read only data. The set support the lookup functionalty of sel.sorted_set, find, count, lower_bound,
+*  upper_bound and equal_range are constexpr. The search is a branch free binary search over a
+*  size known at compile time, so the compiler can unroll it completely.
+*
+*    constexpr auto ports = sel::make_static_sorted_set<int>({443, 80, 22});
+*    static_assert(ports.count(80) == 1, "");
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#if __cplusplus < 201402L
+#error "static_sorted_set.hpp requires C++14"
+#endif
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace sel
+{
+    template <class Key, std::size_t N>
+    class static_sorted_set {
+        static_assert(N > 0, "static_sorted_set needs at least one element");
+
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type &reference;
+        typedef const value_type &const_reference;
+        typedef const value_type *pointer;
+        typedef const value_type *const_pointer;
+        typedef const value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef std::reverse_iterator<const_iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        value_type m_container[N];
+
+        constexpr const_iterator search_lower(const Key &key) const
+        {
+            const_iterator first = m_container;
+            size_type length = N;
+            while (length > 1)
+            {
+                auto half = length / 2;
+                first += (first[half - 1] < key) ? half : 0;
+                length -= half;
+            }
+            return first + ((length == 1 && *first < key) ? 1 : 0);
+        }
+
+        constexpr const_iterator search_upper(const Key &key) const
+        {
+            const_iterator first = m_container;
+            size_type length = N;
+            while (length > 1)
+            {
+                auto half = length / 2;
+                first += !(key < first[half - 1]) ? half : 0;
+                length -= half;
+            }
+            return first + ((length == 1 && !(key < *first)) ? 1 : 0);
+        }
+
+    public:
+
+        constexpr explicit static_sorted_set(const value_type (&init)[N]) : m_container{}
+        {
+            for (size_type i = 0; i < N; ++i)
+            {
+                auto value = init[i];
+                auto j = i;
+                for (; j > 0 && value < m_container[j - 1]; --j)
+                {
+                    m_container[j] = m_container[j - 1];
+                }
+                if (j > 0 && !(m_container[j - 1] < value))
+                {
+                    throw std::invalid_argument("duplicate key in static_sorted_set");
+                }
+                m_container[j] = value;
+            }
+        }
+
+        constexpr const_iterator begin() const noexcept
+        {
+            return m_container;
+        }
+
+        constexpr const_iterator cbegin() const noexcept
+        {
+            return m_container;
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return m_container + N;
+        }
+
+        constexpr const_iterator cend() const noexcept
+        {
+            return m_container + N;
+        }
+
+        const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        constexpr bool empty() const noexcept
+        {
+            return false;
+        }
+
+        constexpr size_type size() const noexcept
+        {
+            return N;
+        }
+
+        constexpr size_type max_size() const noexcept
+        {
+            return N;
+        }
+
+        constexpr size_type count(const Key &key) const
+        {
+            return find(key) == cend() ? 0 : 1;
+        }
+
+        constexpr const_iterator find(const Key &key) const
+        {
+            auto first = search_lower(key);
+            if (!(first == cend()) && !(key < *first))
+            {
+                return first;
+            }
+            return cend();
+        }
+
+        constexpr const_iterator lower_bound(const Key &key) const
+        {
+            return search_lower(key);
+        }
+
+        constexpr const_iterator upper_bound(const Key &key) const
+        {
+            return search_upper(key);
+        }
+
+        constexpr std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+        }
+    };
+
+    template <class Key, std::size_t N>
+    constexpr static_sorted_set<Key, N> make_static_sorted_set(const Key (&init)[N])
+    {
+        return static_sorted_set<Key, N>(init);
+    }
+
+    template <class K, std::size_t N>
+    constexpr bool operator==(const static_sorted_set<K,N> &lhs, const static_sorted_set<K,N> &rhs)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (lhs.begin()[i] < rhs.begin()[i] || rhs.begin()[i] < lhs.begin()[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class K, std::size_t N>
+    constexpr bool operator!=(const static_sorted_set<K,N> &lhs, const static_sorted_set<K,N> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
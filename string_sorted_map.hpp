@@ -0,0 +1,694 @@
+/* string_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++17 compatible library that using sorted std::vector to implement std::map
+*  with string keys whose bytes are kept in one shared arena.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the string_sorted_map.hpp
+*  to your C++ project and include it.
+*
+*    #include "string_sorted_map.hpp"
+*
+*  USAGE
+*
+*  The map support the same functionalty as sel.sorted_map<std::string, T> but the sorted vector only holds the
+*  first eight bytes of every key, its offset and length. Keys up to eight bytes live entirely in that prefix,
+*  longer keys are appended to a char arena, so inserting allocates nothing but the amortized vector and arena
+*  growth and most comparisons during a search are decided by the prefix. Erased keys leave dead bytes in the
+*  arena that are removed by compact(), automatically when they outnumber the live bytes.
+*
+*  The elements are read as std::pair<const std::string_view, T&>. The key views point into the map and are
+*  invalidated by the next insert, erase or compact.
+*
+*    auto mymap = sel::string_sorted_map<int>({{"one", 1}, {"two", 2}});
+*    mymap["three"] = 3;
+*    for (auto pair : mymap) std::cout << pair.first << " " << pair.second << "\n";
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#if __cplusplus < 201703L
+#error "string_sorted_map.hpp requires C++17"
+#endif
+
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+namespace sel
+{
+    template <class T, class Allocator = std::allocator<T>>
+    class string_sorted_map
+    {
+        template <class U, class A, class Pred>
+        friend typename string_sorted_map<U, A>::size_type erase_if(string_sorted_map<U, A> &c, Pred pred);
+
+    public:
+        typedef std::string_view key_type;
+        typedef T mapped_type;
+        typedef std::pair<std::string_view, T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+
+        static const size_type prefix_size = 8;
+
+    private:
+        struct slot
+        {
+            char prefix[prefix_size];
+            size_type offset;
+            size_type size;
+            T value;
+        };
+
+        struct probe
+        {
+            char prefix[prefix_size];
+            std::string_view key;
+
+            explicit probe(std::string_view k) : key(k)
+            {
+                std::memset(prefix, 0, prefix_size);
+                std::memcpy(prefix, k.data(), std::min(k.size(), prefix_size));
+            }
+        };
+
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<slot> slot_allocator;
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<char> char_allocator;
+
+        template <class Owner, class Mapped>
+        class basic_iterator {
+            friend class string_sorted_map;
+            Owner *m_owner;
+            size_type m_index;
+
+            basic_iterator(Owner *owner, size_type index) : m_owner(owner), m_index(index) {}
+
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename string_sorted_map::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::pair<const std::string_view, Mapped &> reference;
+
+            struct pointer
+            {
+                reference m_ref;
+
+                const reference *operator->() const
+                {
+                    return &m_ref;
+                }
+            };
+
+            basic_iterator() : m_owner(nullptr), m_index(0) {}
+
+            template <class O, class M>
+            basic_iterator(const basic_iterator<O,M> &other) : m_owner(other.m_owner), m_index(other.m_index) {}
+
+            reference operator*() const
+            {
+                auto &s = m_owner->m_container[m_index];
+                return reference(m_owner->key_of(s), s.value);
+            }
+
+            pointer operator->() const
+            {
+                return pointer{**this};
+            }
+
+            basic_iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                auto result = *this;
+                ++m_index;
+                return result;
+            }
+
+            basic_iterator &operator--()
+            {
+                --m_index;
+                return *this;
+            }
+
+            basic_iterator operator--(int)
+            {
+                auto result = *this;
+                --m_index;
+                return result;
+            }
+
+            template <class O, class M>
+            bool operator==(const basic_iterator<O,M> &other) const
+            {
+                return m_index == other.m_index;
+            }
+
+            template <class O, class M>
+            bool operator!=(const basic_iterator<O,M> &other) const
+            {
+                return !(*this == other);
+            }
+
+            template <class O, class M>
+            friend class basic_iterator;
+        };
+
+    public:
+        typedef basic_iterator<string_sorted_map, T> iterator;
+        typedef basic_iterator<const string_sorted_map, const T> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        std::vector<slot, slot_allocator> m_container;
+        std::vector<char, char_allocator> m_arena;
+        size_type m_dead = 0;
+
+        std::string_view key_of(const slot &s) const
+        {
+            return s.size <= prefix_size ? std::string_view(s.prefix, s.size) : std::string_view(m_arena.data() + s.offset, s.size);
+        }
+
+        int compare(const slot &s, const probe &p) const
+        {
+            auto result = std::memcmp(s.prefix, p.prefix, prefix_size);
+            if (result != 0)
+            {
+                return result;
+            }
+            if (s.size < prefix_size || p.key.size() < prefix_size)
+            {
+                return key_of(s).compare(p.key);
+            }
+            return key_of(s).substr(prefix_size).compare(p.key.substr(prefix_size));
+        }
+
+        size_type search_lower(std::string_view key) const
+        {
+            auto p = probe(key);
+            return std::lower_bound(m_container.begin(), m_container.end(), p, [this](const slot &s, const probe &k) {
+                return compare(s, k) < 0;
+            }) - m_container.begin();
+        }
+
+        size_type search_upper(std::string_view key) const
+        {
+            auto p = probe(key);
+            return std::upper_bound(m_container.begin(), m_container.end(), p, [this](const probe &k, const slot &s) {
+                return compare(s, k) > 0;
+            }) - m_container.begin();
+        }
+
+        size_type search(std::string_view key) const
+        {
+            auto index = search_lower(key);
+            if (index != m_container.size() && key_of(m_container[index]) == key)
+            {
+                return index;
+            }
+            return m_container.size();
+        }
+
+        template <class... Args>
+        iterator insert_at(size_type index, std::string_view key, Args &&...args)
+        {
+            auto offset = m_arena.size();
+            if (key.size() > prefix_size)
+            {
+                if (key.data() >= m_arena.data() && key.data() < m_arena.data() + offset)
+                {
+                    // The key is a view into the arena, copy it by position since growing may reallocate.
+                    auto source = static_cast<size_type>(key.data() - m_arena.data());
+                    m_arena.resize(offset + key.size());
+                    std::memcpy(m_arena.data() + offset, m_arena.data() + source, key.size());
+                }
+                else
+                {
+                    m_arena.insert(m_arena.end(), key.begin(), key.end());
+                }
+                key = std::string_view(m_arena.data() + offset, key.size());
+            }
+            auto p = probe(key);
+            auto &s = *m_container.insert(m_container.begin() + index, slot{{}, offset, key.size(), T(std::forward<Args>(args)...)});
+            std::memcpy(s.prefix, p.prefix, prefix_size);
+            return iterator(this, index);
+        }
+
+        void release(size_type first, size_type last)
+        {
+            for (auto i = first; i != last; ++i)
+            {
+                if (m_container[i].size > prefix_size)
+                {
+                    m_dead += m_container[i].size;
+                }
+            }
+            if (should_compact())
+            {
+                compact_except(first, last);
+            }
+        }
+
+        bool should_compact() const
+        {
+            return m_dead > 4096 && m_dead * 2 > m_arena.size();
+        }
+
+        void compact_except(size_type first, size_type last)
+        {
+            auto arena = std::vector<char, char_allocator>(m_arena.get_allocator());
+            arena.reserve(m_arena.size() - m_dead);
+            for (size_type i = 0; i != m_container.size(); ++i)
+            {
+                auto &s = m_container[i];
+                if (s.size > prefix_size && (i < first || i >= last))
+                {
+                    auto key = key_of(s);
+                    s.offset = arena.size();
+                    arena.insert(arena.end(), key.begin(), key.end());
+                }
+            }
+            m_arena.swap(arena);
+            m_dead = 0;
+        }
+
+    public:
+
+        string_sorted_map() : m_container(), m_arena() {}
+
+        explicit string_sorted_map(const Allocator &alloc) : m_container(slot_allocator(alloc)), m_arena(char_allocator(alloc)) {}
+
+        template <class InputIt>
+        string_sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : string_sorted_map(alloc)
+        {
+            insert(first, last);
+        }
+
+        string_sorted_map(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+            : string_sorted_map(std::begin(init), std::end(init), alloc)
+        {
+        }
+
+        string_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return allocator_type(m_container.get_allocator());
+        }
+
+        T &at(std::string_view key)
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+            {
+                throw std::out_of_range("failed to find key in string_sorted_map");
+            }
+            return m_container[index].value;
+        }
+
+        const T &at(std::string_view key) const
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+            {
+                throw std::out_of_range("failed to find key in string_sorted_map");
+            }
+            return m_container[index].value;
+        }
+
+        T &operator[](std::string_view key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(this, m_container.size());
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(this, m_container.size());
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator(this, m_container.size());
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size();
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap, size_type arena_cap = 0)
+        {
+            m_container.reserve(new_cap);
+            m_arena.reserve(arena_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        size_type arena_size() const noexcept
+        {
+            return m_arena.size();
+        }
+
+        size_type dead_bytes() const noexcept
+        {
+            return m_dead;
+        }
+
+        // Copies the live long keys into a new arena in key order.
+        void compact()
+        {
+            compact_except(0, 0);
+        }
+
+        void shrink_to_fit()
+        {
+            compact();
+            m_container.shrink_to_fit();
+            m_arena.shrink_to_fit();
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+            m_arena.clear();
+            m_dead = 0;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        template <class P>
+        std::pair<iterator, bool> insert(P &&value)
+        {
+            return emplace(std::forward<P>(value));
+        }
+
+        iterator insert(const_iterator hint, const value_type &value)
+        {
+            return try_emplace(hint, value.first, value.second);
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                try_emplace(cend(), first->first, first->second);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(std::string_view key, M &&obj)
+        {
+            auto result = try_emplace(key, std::forward<M>(obj));
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(obj);
+            }
+            return result;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            auto value = value_type(std::forward<Args>(args)...);
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(std::string_view key, Args &&...args)
+        {
+            auto index = search_lower(key);
+            if (index != m_container.size() && key_of(m_container[index]) == key)
+            {
+                return std::make_pair(iterator(this, index), false);
+            }
+            return std::make_pair(insert_at(index, key, std::forward<Args>(args)...), true);
+        }
+
+        template <class... Args>
+        iterator try_emplace(const_iterator hint, std::string_view key, Args &&...args)
+        {
+            auto index = hint.m_index;
+            if ((index == 0 || key_of(m_container[index - 1]) < key) && (index == m_container.size() || key < key_of(m_container[index])))
+            {
+                return insert_at(index, key, std::forward<Args>(args)...);
+            }
+            return try_emplace(key, std::forward<Args>(args)...).first;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, std::next(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            release(first.m_index, last.m_index);
+            m_container.erase(m_container.begin() + first.m_index, m_container.begin() + last.m_index);
+            return iterator(this, first.m_index);
+        }
+
+        size_type erase(std::string_view key)
+        {
+            auto index = search(key);
+            if (index == m_container.size())
+                return 0;
+            erase(const_iterator(this, index));
+            return 1;
+        }
+
+        void swap(string_sorted_map &other)
+        {
+            m_container.swap(other.m_container);
+            m_arena.swap(other.m_arena);
+            std::swap(m_dead, other.m_dead);
+        }
+
+        size_type count(std::string_view key) const
+        {
+            return search(key) == m_container.size() ? 0 : 1;
+        }
+
+        iterator find(std::string_view key)
+        {
+            return iterator(this, search(key));
+        }
+
+        const_iterator find(std::string_view key) const
+        {
+            return const_iterator(this, search(key));
+        }
+
+        bool contains(std::string_view key) const
+        {
+            return search(key) != m_container.size();
+        }
+
+        iterator lower_bound(std::string_view key)
+        {
+            return iterator(this, search_lower(key));
+        }
+
+        const_iterator lower_bound(std::string_view key) const
+        {
+            return const_iterator(this, search_lower(key));
+        }
+
+        iterator upper_bound(std::string_view key)
+        {
+            return iterator(this, search_upper(key));
+        }
+
+        const_iterator upper_bound(std::string_view key) const
+        {
+            return const_iterator(this, search_upper(key));
+        }
+
+        std::pair<iterator, iterator> equal_range(std::string_view key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(std::string_view key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+    };
+
+    template <class T, class Allocator>
+    const typename string_sorted_map<T, Allocator>::size_type string_sorted_map<T, Allocator>::prefix_size;
+
+    template <class U, class A>
+    bool operator==(const string_sorted_map<U, A> &lhs, const string_sorted_map<U, A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), [](auto a, auto b) {
+            return a.first == b.first && a.second == b.second;
+        });
+    }
+
+    template <class U, class A>
+    bool operator!=(const string_sorted_map<U, A> &lhs, const string_sorted_map<U, A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class U, class A>
+    void swap(string_sorted_map<U, A> &lhs, string_sorted_map<U, A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class U, class A, class Pred>
+    typename string_sorted_map<U, A>::size_type erase_if(string_sorted_map<U, A> &c, Pred pred)
+    {
+        typedef typename string_sorted_map<U, A>::iterator::reference reference;
+        auto &slots = c.m_container;
+        typename string_sorted_map<U, A>::size_type kept = 0;
+        for (typename string_sorted_map<U, A>::size_type i = 0; i != slots.size(); ++i)
+        {
+            if (pred(reference(c.key_of(slots[i]), slots[i].value)))
+            {
+                c.m_dead += slots[i].size > c.prefix_size ? slots[i].size : 0;
+            }
+            else
+            {
+                if (kept != i)
+                {
+                    slots[kept] = std::move(slots[i]);
+                }
+                ++kept;
+            }
+        }
+        auto erased = slots.size() - kept;
+        slots.erase(slots.begin() + kept, slots.end());
+        if (c.should_compact())
+        {
+            c.compact();
+        }
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
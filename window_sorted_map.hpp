@@ -0,0 +1,642 @@
+/* window_sorted_map.hpp - v0.1 - public domain data structures - Stefan Elmlund 2024
+*
+*  This is a single-header-file C++11 compatible library that using sorted std::vector to implement std::map
+*  for keys that mostly arrive in increasing order and leave from the front, like timestamps in a time-series
+*  buffer or a sliding window.
+*
+*  INSTALL
+*
+*  The easiest way to install the library to your C/C++ project is to copy 'n' paste the window_sorted_map.hpp
+*  to your C++ project and include it.
+*
+*    #include "window_sorted_map.hpp"
+*
+*  USAGE
+*
+*  This map support the same functionalty as sel.sorted_map. The live elements are the tail of the vector from
+*  a head offset: a key greater than the current maximum is appended without a search, pop_front() and
+*  trim_before(key) only advance the head, and an out of order insert or erase shifts the shorter side of the
+*  vector. Removed elements are reset to value_type() at once, so a mapped value that owns memory or a handle
+*  releases it right away, and Key and T must be default constructible unless they are trivially destructible.
+*  The dead prefix is destroyed when it grows as large as the live window, or earlier when that lets an append
+*  reuse the capacity instead of reallocating, so it costs amortized O(1) per removed element. Any insert or
+*  removal can invalidate iterators. pop_front() on an empty map does nothing.
+*
+*    auto series = sel::window_sorted_map<std::int64_t, double>();
+*    series.insert(series.end(), {now, sample});    // O(1) append
+*    series.trim_before(now - window);             // O(k) eviction
+*
+*  LICENSE
+*
+*  Placed in the public domain and also MIT licensed.
+*  See end of file for detailed license information.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sel
+{
+    template <class Key, class T, class Allocator = std::allocator<std::pair<Key,T>>>
+    class window_sorted_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key,T> value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Allocator allocator_type;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename std::allocator_traits<Allocator>::pointer pointer;
+        typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+        typedef typename std::vector<value_type, Allocator>::iterator iterator;
+        typedef typename std::vector<value_type, Allocator>::const_iterator const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        std::vector<value_type, allocator_type> m_container;
+        size_type m_head = 0;
+        size_type m_appends = 0;
+
+        template <class It>
+        static It search_lower(It first, It last, const Key &key)
+        {
+            return std::lower_bound(first, last, key, [](const value_type& vt, const Key& k) {
+                return vt.first < k;
+            });
+        }
+
+        template <class It>
+        static It search_upper(It first, It last, const Key &key)
+        {
+            return std::upper_bound(first, last, key, [](const Key& k, const value_type& vt) {
+                return k < vt.first;
+            });
+        }
+
+        void compact()
+        {
+            m_container.erase(m_container.begin(), m_container.begin() + m_head);
+            m_head = 0;
+        }
+
+        void release(size_type, size_type, std::true_type)
+        {
+        }
+
+        // Resets the evicted elements so that what they own is freed now and not at the next compaction.
+        void release(size_type first, size_type last, std::false_type)
+        {
+            for (auto i = first; i < last; ++i)
+            {
+                m_container[i] = value_type();
+            }
+        }
+
+        void advance_head(size_type count)
+        {
+            release(m_head, m_head + count, std::is_trivially_destructible<value_type>());
+            m_head += count;
+            if (m_head == m_container.size())
+            {
+                m_container.clear();
+                m_head = 0;
+            }
+            else if (m_head >= m_container.size() - m_head)
+            {
+                compact();
+            }
+        }
+
+        template <class V>
+        iterator append(V &&value)
+        {
+            if (m_head > 0 && m_container.size() == m_container.capacity() && 4 * m_head >= m_container.capacity())
+            {
+                compact();
+            }
+            ++m_appends;
+            m_container.push_back(std::forward<V>(value));
+            return m_container.end() - 1;
+        }
+
+        template <class V>
+        iterator insert_at(const_iterator pos, V &&value)
+        {
+            if (pos == m_container.cend())
+            {
+                return append(std::forward<V>(value));
+            }
+            auto index = static_cast<size_type>(pos - m_container.cbegin());
+            if (m_head > 0 && index - m_head < m_container.size() - index)
+            {
+                auto first = m_container.begin() + m_head;
+                auto itr = std::move(first, m_container.begin() + index, first - 1);
+                *itr = std::forward<V>(value);
+                --m_head;
+                return itr;
+            }
+            return m_container.insert(pos, std::forward<V>(value));
+        }
+
+        template <class V>
+        iterator insert_hint(const_iterator pos, V &&value)
+        {
+            if ((pos == cbegin() || (pos - 1)->first < value.first) && (pos == cend() || value.first < pos->first))
+            {
+                return insert_at(pos, std::forward<V>(value));
+            }
+            return insert(std::forward<V>(value)).first;
+        }
+
+        template <class V>
+        std::pair<iterator, bool> insert_value(V &&value)
+        {
+            if (empty() || m_container.back().first < value.first)
+            {
+                return std::make_pair(append(std::forward<V>(value)), true);
+            }
+            auto first = search_lower(begin(), end(), value.first);
+            if (!(value.first < first->first))
+            {
+                return std::make_pair(first, false);
+            }
+            return std::make_pair(insert_at(first, std::forward<V>(value)), true);
+        }
+
+    public:
+
+        window_sorted_map() : m_container() {}
+
+        explicit window_sorted_map(const Allocator &alloc) : m_container(alloc) {}
+
+        template <class InputIt>
+        window_sorted_map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+            : m_container(alloc)
+        {
+            for (auto itr = first; itr != last; ++itr)
+            {
+                insert(*itr);
+            }
+        }
+
+        window_sorted_map(std::initializer_list<std::pair<Key,T>> init, const Allocator &alloc = Allocator())
+            : window_sorted_map(init.begin(), init.end(), alloc)
+        {
+        }
+
+        window_sorted_map(const window_sorted_map &other)
+            : m_container(other.cbegin(), other.cend(), std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())), m_appends(other.m_appends)
+        {
+        }
+
+        window_sorted_map(window_sorted_map &&other) noexcept
+            : m_container(std::move(other.m_container)), m_head(other.m_head), m_appends(other.m_appends)
+        {
+            other.m_head = 0;
+        }
+
+        ~window_sorted_map() = default;
+
+        window_sorted_map &operator=(const window_sorted_map &other)
+        {
+            if (this != &other)
+            {
+                m_container.assign(other.cbegin(), other.cend());
+                m_head = 0;
+                m_appends = other.m_appends;
+            }
+            return *this;
+        }
+
+        window_sorted_map &operator=(window_sorted_map &&other) noexcept
+        {
+            m_container = std::move(other.m_container);
+            m_head = other.m_head;
+            m_appends = other.m_appends;
+            other.m_container.clear();
+            other.m_head = 0;
+            return *this;
+        }
+
+        window_sorted_map &operator=(std::initializer_list<value_type> ilist)
+        {
+            clear();
+            insert(ilist);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        {
+            return m_container.get_allocator();
+        }
+
+        T& at(const Key& key)
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in window_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto find_result = find(key);
+            if(find_result == end()) {
+                throw std::out_of_range("failed to find key in window_sorted_map");
+            }
+            return find_result->second;
+        }
+
+        T& operator[](const Key& key)
+        {
+            if (empty() || m_container.back().first < key)
+            {
+                return append(value_type(key, T()))->second;
+            }
+            auto first = search_lower(begin(), end(), key);
+            if (key < first->first)
+            {
+                first = insert_at(first, value_type(key, T()));
+            }
+            return first->second;
+        }
+
+        iterator begin() noexcept
+        {
+            return m_container.begin() + m_head;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_container.cbegin() + m_head;
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return m_container.cbegin() + m_head;
+        }
+
+        iterator end() noexcept
+        {
+            return m_container.end();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return m_container.cend();
+        }
+
+        reverse_iterator rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        reverse_iterator rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_container.size() == m_head;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_container.size() - m_head;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return m_container.max_size();
+        }
+
+        void reserve(size_type new_cap)
+        {
+            compact();
+            m_container.reserve(new_cap);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_container.capacity();
+        }
+
+        void shrink_to_fit()
+        {
+            compact();
+            m_container.shrink_to_fit();
+        }
+
+        // Number of inserts that took the append fast path.
+        size_type append_count() const noexcept
+        {
+            return m_appends;
+        }
+
+        void clear() noexcept
+        {
+            m_container.clear();
+            m_head = 0;
+        }
+
+        value_type &front()
+        {
+            return m_container[m_head];
+        }
+
+        const value_type &front() const
+        {
+            return m_container[m_head];
+        }
+
+        value_type &back()
+        {
+            return m_container.back();
+        }
+
+        const value_type &back() const
+        {
+            return m_container.back();
+        }
+
+        void pop_front()
+        {
+            if (empty())
+            {
+                return;
+            }
+            advance_head(1);
+        }
+
+        // Removes the elements with keys less than key, returns how many.
+        size_type trim_before(const Key &key)
+        {
+            auto count = static_cast<size_type>(search_lower(begin(), end(), key) - begin());
+            if (count > 0)
+            {
+                advance_head(count);
+            }
+            return count;
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value)
+        {
+            return insert_value(value);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value)
+        {
+            return insert_value(std::move(value));
+        }
+
+        iterator insert(const_iterator pos, const value_type &value)
+        {
+            return insert_hint(pos, value);
+        }
+
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            return insert_hint(pos, std::move(value));
+        }
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        {
+            insert(std::begin(ilist), std::end(ilist));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            return insert_value(value_type(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args &&...args)
+        {
+            return insert_hint(hint, value_type(std::forward<Args>(args)...));
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            auto index = static_cast<size_type>(first - m_container.cbegin());
+            auto count = static_cast<size_type>(last - first);
+            if (count == 0)
+            {
+                return m_container.begin() + index;
+            }
+            if (index - m_head < static_cast<size_type>(m_container.cend() - last))
+            {
+                auto offset = index - m_head;
+                auto head = m_container.begin() + m_head;
+                std::move_backward(head, m_container.begin() + index, m_container.begin() + index + count);
+                advance_head(count);
+                return begin() + offset;
+            }
+            return m_container.erase(first, last);
+        }
+
+        size_type erase(const Key &key)
+        {
+            auto find_result = find(key);
+            if (find_result == end())
+                return 0;
+            erase(find_result);
+            return 1;
+        }
+
+        void swap(window_sorted_map &other)
+        {
+            m_container.swap(other.m_container);
+            std::swap(m_head, other.m_head);
+            std::swap(m_appends, other.m_appends);
+        }
+
+        size_type count(const Key &key) const
+        {
+            return find(key) == cend() ? 0 : 1;
+        }
+
+        iterator find(const Key &key)
+        {
+            auto find_result = search_lower(begin(), end(), key);
+            if (!(find_result == end()) && !(key < find_result->first))
+            {
+                return find_result;
+            }
+            return end();
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            auto find_result = search_lower(cbegin(), cend(), key);
+            if (!(find_result == cend()) && !(key < find_result->first))
+            {
+                return find_result;
+            }
+            return cend();
+        }
+
+        iterator lower_bound(const Key &key)
+        {
+            return search_lower(begin(), end(), key);
+        }
+
+        const_iterator lower_bound(const Key &key) const
+        {
+            return search_lower(cbegin(), cend(), key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key)
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const
+        {
+            return std::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        iterator upper_bound(const Key &key)
+        {
+            return search_upper(begin(), end(), key);
+        }
+
+        const_iterator upper_bound(const Key &key) const
+        {
+            return search_upper(cbegin(), cend(), key);
+        }
+    };
+
+    template <class K, class V, class A>
+    bool operator==(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
+
+    template <class K, class V, class A>
+    bool operator!=(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class K, class V, class A>
+    bool operator<(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    }
+
+    template <class K, class V, class A>
+    bool operator<=(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class K, class V, class A>
+    bool operator>(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class K, class V, class A>
+    bool operator>=(const window_sorted_map<K,V,A> &lhs, const window_sorted_map<K,V,A> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    template <class K, class V, class A>
+    void swap(window_sorted_map<K,V,A> &lhs, window_sorted_map<K,V,A> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class K, class V, class A, class Pred>
+    typename window_sorted_map<K,V,A>::size_type erase_if(window_sorted_map<K,V,A> &c, Pred pred)
+    {
+        auto first = std::remove_if(c.begin(), c.end(), pred);
+        auto erased = std::distance(first, c.end());
+        c.erase(first, c.end());
+        return erased;
+    }
+}
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2023 Stefan Elmlund
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/